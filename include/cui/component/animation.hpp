@@ -22,10 +22,12 @@
 
 #include <chrono>
 #include <cstdint>
+#include <type_traits>
 #include <cui/component/hook.hpp>
 #include <cui/core/component.hpp>
 #include <cui/core/rect.hpp>
 #include <cui/fwd.hpp>
+#include <cui/util/type.hpp>
 
 namespace cui {
 using Delta = std::chrono::milliseconds;
@@ -37,6 +39,9 @@ public:
   using HookComponent::HookComponent;
 };
 
+template <>
+struct type_trait<AnimationComponent> : std::integral_constant<TypeID, 7> {};
+
 /// Updates the AnimationComponent of a tree of nodes and returns the
 /// min time delta when the next update shall happen.
 CUI_API Delta animate(Node& node, Delta diff) noexcept;
@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <type_traits>
 #include <cui/core/component.hpp>
 #include <cui/fwd.hpp>
+#include <cui/util/type.hpp>
 
 namespace cui {
 class CUI_API DropComponent : public Component {
@@ -32,4 +34,7 @@ public:
   /// Is called before the Node is destroyed
   virtual void onDestroy() noexcept {}
 };
+
+template <>
+struct type_trait<DropComponent> : std::integral_constant<TypeID, 5> {};
 } // namespace cui
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 #include <cui/core/component.hpp>
 #include <cui/core/math.hpp>
 #include <cui/fwd.hpp>
@@ -58,7 +59,7 @@ public:
   Return operator()(Args... args) const {
     Node& receiver = *reinterpret_cast<Node*>(
         reinterpret_cast<std::uintptr_t>(this) + receiver_offset_);
-    return fn_(receiver, std::move(args)...);
+    return fn_(receiver, std::forward<Args>(args)...);
   }
 
 private:
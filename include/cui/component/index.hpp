@@ -0,0 +1,122 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <cui/core/component.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/type.hpp>
+
+namespace cui {
+class ComponentIndexBase;
+
+template <>
+struct type_trait<ComponentIndexBase> : std::integral_constant<TypeID, 2> {};
+
+/// A Component that indexes the Components of its owning Node by their TypeID,
+/// which makes Node::find a binary search instead of a walk over the sorted
+/// list of Components.
+///
+/// The index is worth it for Nodes that carry many Components of different
+/// types. Because of its reserved TypeID it always is the first Component of
+/// the Node and it is kept up to date while further Components are attached.
+/// The entries store the offsets of the Components relative to the Node, thus
+/// the index stays valid when the Node is moved together with its Components.
+///
+/// If the capacity of the index is exceeded, lookups fall back to the walk.
+///
+/// \attention A Node can only carry a single index.
+class CUI_API ComponentIndexBase : public Component {
+  friend Node;
+  friend struct NodeImpl;
+
+public:
+  /// Describes the first Component of a TypeID
+  struct Entry {
+    TypeID type;
+    Offset offset; // relative to the owner
+  };
+
+  ComponentIndexBase(ComponentIndexBase&&) noexcept = default;
+  ComponentIndexBase& operator=(ComponentIndexBase&&) noexcept = default;
+
+  /// Returns the count of indexed TypeIDs
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns false if the capacity of the index was exceeded
+  [[nodiscard]] constexpr bool complete() const noexcept {
+    return complete_;
+  }
+
+protected:
+  explicit ComponentIndexBase(Node& owner, Entry* entries,
+                              std::size_t capacity) noexcept;
+  ~ComponentIndexBase() noexcept = default;
+
+  /// Indexes all Components that are attached to the owner
+  void rebuild() noexcept;
+
+private:
+  /// Returns the first Component of the given TypeID or nullptr
+  [[nodiscard]] Component* find(TypeID type) const noexcept;
+
+  /// Indexes the given Component if it is the first of its TypeID
+  void insert(TypeID type, Offset offset) noexcept;
+
+  [[nodiscard]] Entry* entries() const noexcept;
+
+  Offset entries_offset_;
+  std::uint8_t size_{0};
+  std::uint8_t capacity_;
+  bool complete_{false};
+};
+
+/// A ComponentIndex that is able to index N different TypeIDs
+///
+/// ```cpp
+/// class MyWidget : public Widget {
+///   ComponentIndex<8> index_{*this};
+///   MyInputComponent input_{*this, ...};
+///   ...
+/// };
+/// ```
+template <std::size_t N>
+class ComponentIndex final : public ComponentIndexBase {
+  static_assert(N <= 0xFF);
+
+public:
+  explicit ComponentIndex(Node& owner) noexcept
+    : ComponentIndexBase(owner, entries_, N) {
+    rebuild();
+  }
+
+  ComponentIndex(ComponentIndex&&) noexcept = default;
+  ComponentIndex& operator=(ComponentIndex&&) noexcept = default;
+
+private:
+  Entry entries_[N];
+};
+} // namespace cui
@@ -21,10 +21,12 @@
 #pragma once
 
 #include <cstdint>
+#include <type_traits>
 #include <cui/component/hook.hpp>
 #include <cui/core/component.hpp>
 #include <cui/core/rect.hpp>
 #include <cui/fwd.hpp>
+#include <cui/util/type.hpp>
 
 namespace cui {
 enum class InputEvent : std::uint16_t {
@@ -44,6 +46,9 @@ public:
   using HookComponent::HookComponent;
 };
 
+template <>
+struct type_trait<InputComponent> : std::integral_constant<TypeID, 6> {};
+
 // CUI_API Node const* focus_next(Node const& tree, Rect const& current)
 // noexcept; CUI_API Node const* focus_next(Node const& tree, Node const&
 // current) noexcept;
@@ -0,0 +1,96 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <type_traits>
+#include <cui/core/component.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/type.hpp>
+
+namespace cui {
+class LayerComponent;
+
+template <>
+struct type_trait<LayerComponent> : std::integral_constant<TypeID, 11> {};
+
+/// A Component that turns its owning Container into a repaint boundary,
+/// which retains the painted content of its children in an offscreen layer.
+///
+/// When the Container is painted again without any change inside its
+/// subtree, for instance because it was moved or because a sibling was
+/// repainted over it, the retained layer is composited instead of painting
+/// the children again.
+///
+/// The layer is invalidated when a Node inside the subtree becomes paint
+/// dirty or the structure of the subtree changes. Partial paints update
+/// dirty Nodes directly, the layer is recorded again on the next paint
+/// which composites it. Implementations define
+/// the pixel format and the memory budget of the layer, \see RasterLayer.
+class CUI_API LayerComponent : public Component {
+  friend struct NodeImpl;
+
+public:
+  explicit LayerComponent(Node& owner) noexcept;
+  virtual ~LayerComponent() noexcept = default;
+
+  LayerComponent(LayerComponent&& other) noexcept;
+  LayerComponent& operator=(LayerComponent&& other) noexcept;
+
+  /// Returns true if the layer retains the current content of the subtree
+  [[nodiscard]] constexpr bool isValid() const noexcept {
+    return valid_;
+  }
+
+  /// Forces the layer to be recorded again on the next paint
+  void invalidate() noexcept {
+    valid_ = false;
+  }
+
+  /// Records the layer if needed for the visible area of its owner
+  ///
+  /// \returns false if the layer can not retain the visible area, the
+  ///          children of the owner have to be painted directly then.
+  bool prepare(Surface& surface, Vec2 translation,
+               Rect const& visible) noexcept;
+
+  /// Draws the retained layer inside the given clip space
+  void composite(Surface& surface, Vec2 translation,
+                 Rect const& clip) noexcept;
+
+protected:
+  /// Paints the children of the owner into the layer
+  ///
+  /// \param visible The absolute area of the owner to retain
+  virtual bool record(Surface& surface, Rect const& visible) noexcept = 0;
+
+  /// Draws the layer which retains the given absolute area
+  virtual void draw(Surface& surface, Rect const& area,
+                    Rect const& clip) noexcept = 0;
+
+private:
+  // The retained area relative to the owner
+  Rect recorded_{Rect::none()};
+  bool valid_{false};
+};
+} // namespace cui
@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <type_traits>
 #include <cui/core/component.hpp>
 #include <cui/fwd.hpp>
+#include <cui/util/type.hpp>
 
 namespace cui {
 class CUI_API MountComponent : public Component {
@@ -35,4 +37,7 @@ public:
   /// Is called after the owning Node is detached from its parent
   virtual void onDismount(Container& parent) noexcept {}
 };
+
+template <>
+struct type_trait<MountComponent> : std::integral_constant<TypeID, 3> {};
 } // namespace cui
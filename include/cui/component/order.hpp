@@ -0,0 +1,121 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <cui/core/component.hpp>
+#include <cui/core/def.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/span.hpp>
+#include <cui/util/type.hpp>
+
+namespace cui {
+class SiblingOrderBase;
+
+template <>
+struct type_trait<SiblingOrderBase> : std::integral_constant<TypeID, 14> {};
+
+/// The type erased base of a SiblingOrder
+///
+/// Keeps the children of its owning Container sorted by their left edge,
+/// such that collision checks between siblings only compare the children
+/// which overlap horizontally.
+///
+/// The children are collected again when a child is inserted, erased or
+/// moved, and resorted when a child changes its area. Both happen lazily on
+/// the next query. Since layouts mostly shift children slightly, the previous
+/// order is resorted incrementally.
+class CUI_API SiblingOrderBase : public Component {
+  friend struct NodeImpl;
+
+public:
+  SiblingOrderBase(SiblingOrderBase&& other) noexcept;
+  SiblingOrderBase& operator=(SiblingOrderBase&& other) noexcept;
+
+  /// Brings the order up to date
+  ///
+  /// \returns false if the children don't fit into the order
+  [[nodiscard]] bool available() noexcept;
+
+  /// Returns the children sorted by their left edge, requires \see available
+  [[nodiscard]] Span<Node const* const> entries() const noexcept;
+
+  /// Returns true if the given child collides with any of its visible
+  /// siblings, requires \see available
+  [[nodiscard]] bool collides(Node const& child) const noexcept;
+
+  /// Forces the children to be collected again on the next access
+  void invalidate() noexcept {
+    stale_ = true;
+  }
+
+  [[nodiscard]] constexpr bool isStale() const noexcept {
+    return stale_ || unsorted_;
+  }
+
+protected:
+  explicit SiblingOrderBase(Container& owner, Node const** entries,
+                            std::size_t capacity) noexcept;
+  ~SiblingOrderBase() noexcept = default;
+
+private:
+  [[nodiscard]] Node const** data() const noexcept;
+
+  Offset entries_offset_;
+  std::uint16_t size_{0};
+  std::uint16_t capacity_;
+  // The width of the widest child
+  Point widest_{0};
+  // A child was inserted, erased or moved
+  bool stale_{true};
+  // A child changed its area
+  bool unsorted_{true};
+  bool overflowed_{false};
+};
+
+/// An order of up to Capacity children, placed on the Container to sort:
+///
+/// ```cpp
+/// class Canvas : public Container {
+///   SiblingOrder<64> order_{*this};
+/// };
+/// ```
+///
+/// This pays off for wide Containers whose children are checked for
+/// collisions frequently.
+template <std::size_t Capacity>
+class SiblingOrder final : public SiblingOrderBase {
+  static_assert(Capacity <= 0xFFFF);
+
+public:
+  explicit SiblingOrder(Container& owner) noexcept
+    : SiblingOrderBase(owner, entries_, Capacity) {}
+
+  SiblingOrder(SiblingOrder&&) noexcept = default;
+  SiblingOrder& operator=(SiblingOrder&&) noexcept = default;
+
+private:
+  Node const* entries_[Capacity];
+};
+} // namespace cui
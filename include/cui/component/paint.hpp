@@ -0,0 +1,59 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cui/component/hook.hpp>
+#include <cui/core/canvas.hpp>
+#include <cui/fwd.hpp>
+
+namespace cui {
+/// Specifies a Component that paints a Widget through a BasicCanvas of
+/// the given final Surface type instead of calling Widget::paint.
+///
+/// This allows the draw calls of the Widget to be dispatched statically
+/// when the paint pipeline is invoked with the same Surface type:
+/// ```cpp
+/// class Gauge final : public Widget {
+///   ...
+/// protected:
+///   void paint(Canvas& canvas) const noexcept override {
+///     draw(canvas);
+///   }
+///
+/// private:
+///   template <typename C>
+///   void draw(C& canvas) const noexcept;
+///
+///   PaintComponent<WideRasterSurface> paint_{
+///       *this, bind<&Gauge::draw<BasicCanvas<WideRasterSurface>>>()};
+/// };
+/// ```
+template <typename SurfaceT>
+class PaintComponent final
+  : public HookComponent<PaintComponent<SurfaceT>,
+                         void(BasicCanvas<SurfaceT>&)> {
+  using Base = HookComponent<PaintComponent<SurfaceT>,
+                             void(BasicCanvas<SurfaceT>&)>;
+
+public:
+  using Base::Base;
+};
+} // namespace cui
@@ -30,6 +30,7 @@
 #include <cui/util/assert.hpp>
 #include <cui/util/common.h>
 #include <cui/util/meta.hpp>
+#include <cui/util/type.hpp>
 
 #ifndef CUI_HAS_NO_EXCEPTIONS
 #  include <exception>
@@ -44,6 +45,9 @@ private:
   MountComponent mount_;
 };
 
+template <>
+struct type_trait<RefComponent> : std::integral_constant<TypeID, 4> {};
+
 /// The Ref smart pointer holds a unique reference to a Node which is deleted
 /// if the Ref was released and the Node was removed from its containing tree.
 ///
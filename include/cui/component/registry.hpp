@@ -0,0 +1,197 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <cui/core/component.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/traverse.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/iterator.hpp>
+#include <cui/util/type.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+class RegistryComponent;
+
+template <>
+struct type_trait<RegistryComponent> : std::integral_constant<TypeID, 8> {};
+
+/// The type erased base of a ComponentRegistry
+///
+/// Registries are notified about every Component of their registered type
+/// that appears or disappears inside the subtree of their owner, when a
+/// Node is inserted into or erased from a Container inside the subtree or
+/// when a Component is attached to a Node of the subtree.
+///
+/// This is done by the Container itself rather than through MountComponent,
+/// whose hooks are only called for the inserted Node and only if it carries a
+/// MountComponent, while a registry needs every matching Component of the
+/// inserted subtree and of Components that are attached later on.
+///
+/// Because registries store plain pointers, a registry becomes stale when a
+/// Node inside its subtree or the registry itself is moved in memory and
+/// is lazily rebuilt through a visit of its subtree on the next access.
+class CUI_API RegistryComponent : public Component {
+  friend struct NodeImpl;
+
+public:
+  RegistryComponent(RegistryComponent&& other) noexcept;
+  RegistryComponent& operator=(RegistryComponent&& other) noexcept;
+
+  /// Returns the TypeID of the registered Components
+  [[nodiscard]] constexpr TypeID registered() const noexcept {
+    return registered_;
+  }
+
+  /// Returns false if the capacity of the registry was exceeded
+  ///
+  /// The registry does not reflect the Components of its subtree then and
+  /// has to be bypassed by visiting the subtree.
+  [[nodiscard]] bool complete() noexcept;
+
+  /// Returns the registered Components and rebuilds them if needed
+  [[nodiscard]] Range<Component* const*> entries() noexcept;
+
+protected:
+  explicit RegistryComponent(Node& owner, TypeID registered,
+                             Component** entries,
+                             std::size_t capacity) noexcept;
+  ~RegistryComponent() noexcept = default;
+
+private:
+  /// Registers all matching Components of the given subtree
+  void attach(Node& subtree) noexcept;
+  /// Deregisters all matching Components of the given subtree
+  void detach(Node& subtree) noexcept;
+
+  void add(Component& component) noexcept;
+  void remove(Component& component) noexcept;
+
+  void rebuild() noexcept;
+
+  [[nodiscard]] Component** data() const noexcept;
+
+  TypeID registered_;
+  Offset entries_offset_;
+  std::uint8_t size_{0};
+  std::uint8_t capacity_;
+  bool stale_{true};
+  bool overflowed_{false};
+};
+
+/// A Component that keeps track of all Components of type T inside the
+/// subtree of its owning Node (including the owner itself), such that they
+/// can be iterated in O(k) instead of visiting every Node of the subtree:
+///
+/// ```cpp
+/// class Screen : public Container {
+///   ComponentRegistry<AnimationComponent> animations_{*this};
+/// };
+///
+/// for (AnimationComponent& animation : animations_) {
+///   ...
+/// }
+/// ```
+///
+/// The Capacity is the count of Components that can be registered before the
+/// registry overflows.
+///
+/// \note Prefer visit_components, which falls back to a visit of the
+///       subtree when the registry is missing or overflowed.
+template <typename T, std::size_t Capacity = 16>
+class ComponentRegistry final : public RegistryComponent {
+  static_assert(Capacity <= 0xFF);
+  static_assert(std::is_base_of_v<Component, T>);
+
+public:
+  class iterator : public IteratorFacade<iterator, std::forward_iterator_tag,
+                                         T> {
+  public:
+    constexpr iterator() noexcept = default;
+    explicit constexpr iterator(Component* const* current) noexcept
+      : current_(current) {}
+
+    [[nodiscard]] constexpr bool equal(iterator const& other) const noexcept {
+      return current_ == other.current_;
+    }
+    [[nodiscard]] T& dereference() const noexcept {
+      return static_cast<T&>(**current_);
+    }
+    void increment() noexcept {
+      ++current_;
+    }
+
+  private:
+    Component* const* current_{nullptr};
+  };
+
+  explicit ComponentRegistry(Node& owner) noexcept
+    : RegistryComponent(owner, type_of<T>(), entries_, Capacity) {}
+
+  ComponentRegistry(ComponentRegistry&&) noexcept = default;
+  ComponentRegistry& operator=(ComponentRegistry&&) noexcept = default;
+
+  [[nodiscard]] iterator begin() noexcept {
+    return iterator{entries().begin()};
+  }
+  [[nodiscard]] iterator end() noexcept {
+    return iterator{entries().end()};
+  }
+
+private:
+  Component* entries_[Capacity];
+};
+
+/// Calls the given callback with every Component of type T inside the
+/// subtree of the given Node.
+///
+/// A ComponentRegistry of the Node is used if present, otherwise every Node
+/// of the subtree is visited.
+template <typename T, typename Callback>
+void visit_components(Node& node, Callback&& callback) {
+  if (node.contains(type_of<RegistryComponent>())) {
+    for (Component& component : node.find(type_of<RegistryComponent>())
+                                    ->siblings()) {
+      auto& registry = static_cast<RegistryComponent&>(component);
+
+      if ((registry.registered() == type_of<T>()) && registry.complete()) {
+        for (Component* entry : registry.entries()) {
+          callback(static_cast<T&>(*entry));
+        }
+        return;
+      }
+    }
+  }
+
+  for (Node& current : visit(node)) {
+    if (current.contains(type_of<T>())) {
+      for (Component& component : current.find(type_of<T>())->siblings()) {
+        callback(static_cast<T&>(component));
+      }
+    }
+  }
+}
+} // namespace cui
@@ -0,0 +1,95 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <cui/core/component.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/type.hpp>
+
+namespace cui {
+class ScrollComponent;
+
+template <>
+struct type_trait<ScrollComponent> : std::integral_constant<TypeID, 12> {};
+
+/// A Component that lets its owning Container shift its displayed content
+/// instead of repainting it when its children are scrolled.
+///
+/// Children that are moved through Container::scroll are shifted on the
+/// Surface through Surface::scroll before the next partial paint, afterwards
+/// only the exposed strips of the visible area are painted. Surfaces that
+/// can't shift their content repaint the whole visible area instead.
+///
+/// \attention Content of other Nodes that overlaps the Container is shifted
+///            as well, thus the Container must not be covered by siblings.
+class CUI_API ScrollComponent final : public Component {
+  friend struct NodeImpl;
+
+public:
+  explicit ScrollComponent(Node& owner) noexcept;
+
+  ScrollComponent(ScrollComponent&& other) noexcept;
+  ScrollComponent& operator=(ScrollComponent&& other) noexcept;
+
+  /// Returns the offset by which the displayed content has to be shifted
+  [[nodiscard]] constexpr Vec2 pending() const noexcept {
+    return pending_;
+  }
+
+  /// Returns true if the displayed content does not match the children
+  [[nodiscard]] constexpr bool isPending() const noexcept {
+    return invalid_ || (pending_ != Vec2::origin());
+  }
+
+  /// Returns true if the displayed content can't be shifted anymore
+  [[nodiscard]] constexpr bool isInvalid() const noexcept {
+    return invalid_;
+  }
+
+  /// Marks the displayed content as matching the children
+  void settle() noexcept {
+    pending_ = Vec2::origin();
+    invalid_ = false;
+  }
+
+  /// Forces the whole visible area to be painted again instead of shifted
+  void invalidate() noexcept {
+    invalid_ = true;
+  }
+
+  /// Returns the parts of the area that are exposed when its content is
+  /// shifted by the given offset
+  ///
+  /// \returns The count of strips written, the whole area is returned
+  ///          if the shift does not retain any content.
+  static std::size_t exposed(Rect const& area, Vec2 offset,
+                             Rect (&strips)[2]) noexcept;
+
+private:
+  Vec2 pending_;
+  bool invalid_{false};
+};
+} // namespace cui
@@ -0,0 +1,116 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <type_traits>
+#include <cui/core/arena.hpp>
+#include <cui/core/component.hpp>
+#include <cui/core/grid.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/common.h>
+#include <cui/util/type.hpp>
+
+namespace cui {
+class SpatialIndex;
+
+template <>
+struct type_trait<SpatialIndex> : std::integral_constant<TypeID, 13> {};
+
+/// A Component that indexes the absolute clip spaces of the subtree of its
+/// owning root in a SpatialGrid, which turns hit tests into a lookup of the
+/// Nodes overlapping a single cell instead of a traversal of the tree.
+///
+/// The index is invalidated when the structure of the subtree changes or
+/// when a Node of the subtree changes its area, and it is brought up to date
+/// lazily on the next query. cui::intersection uses the index of the given
+/// Node automatically.
+///
+/// ```cpp
+/// class Screen : public Container {
+///   BasicNodeArena<256> arena_;
+///   BasicSpatialGrid<8, 8, 512> grid_;
+///   SpatialIndex index_{*this, arena_, grid_};
+/// };
+/// ```
+///
+/// \attention The arena and the grid have to outlive the index.
+class CUI_API SpatialIndex final : public Component {
+  friend struct NodeImpl;
+
+public:
+  explicit SpatialIndex(Node& owner, NodeArena& arena,
+                        SpatialGrid& grid) noexcept;
+
+  SpatialIndex(SpatialIndex&& other) noexcept;
+  SpatialIndex& operator=(SpatialIndex&& other) noexcept;
+
+  /// Brings the index up to date
+  ///
+  /// \returns false if the subtree does not fit into the arena,
+  ///          the index can't be queried then.
+  [[nodiscard]] bool available() noexcept;
+
+  /// Returns the deepest Node located at the given position
+  /// or nullptr if no Node is located at it, requires \see available.
+  [[nodiscard]] Node* intersection(Vec2 position) noexcept;
+
+  /// Invokes the visitor with every Node whose clip space overlaps the given
+  /// absolute area, requires \see available.
+  ///
+  /// Falls back to a pass over the arena if the grid overflowed.
+  template <typename T>
+  void overlapping(Rect const& area, T&& visitor) noexcept {
+    CUI_ASSERT(!stale_ && !moved_);
+
+    if (grid_->valid()) {
+      grid_->overlapping(*arena_, area, [&](NodeArena::Index index) {
+        visitor(arena_->node(index));
+      });
+    } else {
+      for (NodeArena::Index i = 0; i < arena_->size(); ++i) {
+        if (arena_->clip(i).overlaps(area)) {
+          visitor(arena_->node(i));
+        }
+      }
+    }
+  }
+
+  /// Forces the index to be rebuilt on the next access
+  void invalidate() noexcept {
+    stale_ = true;
+  }
+
+  [[nodiscard]] constexpr bool isStale() const noexcept {
+    return stale_ || moved_;
+  }
+
+private:
+  NodeArena* arena_;
+  SpatialGrid* grid_;
+  // The structure of the subtree changed
+  bool stale_{true};
+  // The area of a Node inside the subtree changed
+  bool moved_{true};
+};
+} // namespace cui
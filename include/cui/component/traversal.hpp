@@ -0,0 +1,86 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <type_traits>
+#include <cui/core/arena.hpp>
+#include <cui/core/component.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/type.hpp>
+
+namespace cui {
+class TraversalCache;
+
+template <>
+struct type_trait<TraversalCache> : std::integral_constant<TypeID, 9> {};
+
+/// A Component that keeps the subtree of its owning Node flattened inside a
+/// NodeArena, which turns repeated traversals of mostly static trees into
+/// index arithmetic.
+///
+/// The cache is invalidated when a Node is inserted into or erased from a
+/// Container inside the subtree or when a Node of the subtree is moved,
+/// and the arena is reassigned lazily on the next access. The bounds and
+/// clip spaces of the arena are only refreshed when the area of a Node
+/// inside the subtree changed since the last access.
+/// Full paints of the owner are walked through the arena automatically.
+///
+/// ```cpp
+/// class Screen : public Container {
+///   BasicNodeArena<256> arena_;
+///   TraversalCache cache_{*this, arena_};
+/// };
+/// ```
+///
+/// \attention The arena has to outlive the cache.
+class CUI_API TraversalCache final : public Component {
+  friend struct NodeImpl;
+
+public:
+  explicit TraversalCache(Node& owner, NodeArena& arena) noexcept;
+
+  TraversalCache(TraversalCache&& other) noexcept;
+  TraversalCache& operator=(TraversalCache&& other) noexcept;
+
+  /// Returns the flattened subtree of the owner and reassigns or refreshes
+  /// it if needed
+  ///
+  /// \returns nullptr if the subtree does not fit into the arena
+  [[nodiscard]] NodeArena* arena() noexcept;
+
+  /// Forces the arena to be reassigned on the next access
+  void invalidate() noexcept {
+    stale_ = true;
+  }
+
+  [[nodiscard]] constexpr bool isStale() const noexcept {
+    return stale_ || moved_;
+  }
+
+private:
+  NodeArena* arena_;
+  // The structure of the subtree changed
+  bool stale_{true};
+  // The area of a Node inside the subtree changed
+  bool moved_{true};
+};
+} // namespace cui
@@ -0,0 +1,137 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <cui/core/component.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/iterator.hpp>
+#include <cui/util/type.hpp>
+
+namespace cui {
+class PaintWorklistBase;
+
+template <>
+struct type_trait<PaintWorklistBase> : std::integral_constant<TypeID, 10> {};
+
+/// The type erased base of a PaintWorklist
+///
+/// Every Node of the tree that becomes paint dirty is pushed onto the
+/// worklist of its root, a partial paint of the root then repaints the
+/// listed Nodes directly instead of searching them through the tree.
+///
+/// The worklist is invalidated when it overflows, when the structure of the
+/// tree changes or when a Node of the tree is moved, the next partial paint
+/// falls back to a traversal of the tree then.
+///
+/// Additionally the worklist records the previously painted areas of moved
+/// and resized Nodes as damage. A moved Node is repainted at its new area
+/// and its damage is painted from the root, instead of repainting its whole
+/// parent. The parent is repainted if the damage doesn't fit anymore.
+class CUI_API PaintWorklistBase : public Component {
+  friend struct NodeImpl;
+
+public:
+  PaintWorklistBase(PaintWorklistBase&& other) noexcept;
+  PaintWorklistBase& operator=(PaintWorklistBase&& other) noexcept;
+
+  /// Returns false if the worklist misses any dirty Node of the tree
+  [[nodiscard]] constexpr bool complete() const noexcept {
+    return complete_;
+  }
+
+  /// Returns the count of listed Nodes
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns the listed Nodes in the order they became dirty
+  [[nodiscard]] Range<Node* const*> entries() const noexcept;
+
+  /// Returns the absolute areas that have to be painted from the root
+  [[nodiscard]] Range<Rect const*> damage() const noexcept;
+
+  /// Empties the worklist and the damage after all dirty Nodes
+  /// of the tree were painted
+  void clear() noexcept;
+
+  /// Forces the next partial paint to traverse the tree
+  void invalidate() noexcept;
+
+protected:
+  explicit PaintWorklistBase(Node& owner, Node** entries, std::size_t capacity,
+                             Rect* damage,
+                             std::size_t damage_capacity) noexcept;
+  ~PaintWorklistBase() noexcept = default;
+
+private:
+  void push(Node& node) noexcept;
+
+  /// Records the given absolute area as damage, which is merged into
+  /// an overlapping area if possible
+  ///
+  /// \returns false if the damage doesn't fit into the worklist
+  bool record(Rect const& area) noexcept;
+
+  [[nodiscard]] Node** data() const noexcept;
+  [[nodiscard]] Rect* damage_data() const noexcept;
+
+  Offset entries_offset_;
+  Offset damage_offset_;
+  std::uint16_t size_{0};
+  std::uint16_t capacity_;
+  std::uint8_t damage_size_{0};
+  std::uint8_t damage_capacity_;
+  bool complete_{false};
+};
+
+/// A worklist of up to Capacity dirty Nodes and Damage damaged areas,
+/// placed on the root of a tree:
+///
+/// ```cpp
+/// class Screen : public Container {
+///   PaintWorklist<16> worklist_{*this};
+/// };
+/// ```
+///
+/// This pays off for wide trees such as lists and grids where only a few
+/// Nodes change between two paints.
+template <std::size_t Capacity, std::size_t Damage = 4>
+class PaintWorklist final : public PaintWorklistBase {
+  static_assert(Capacity <= 0xFFFF);
+  static_assert((Damage > 0) && (Damage <= 0xFF));
+
+public:
+  explicit PaintWorklist(Node& owner) noexcept
+    : PaintWorklistBase(owner, entries_, Capacity, damage_, Damage) {}
+
+  PaintWorklist(PaintWorklist&&) noexcept = default;
+  PaintWorklist& operator=(PaintWorklist&&) noexcept = default;
+
+private:
+  Node* entries_[Capacity];
+  Rect damage_[Damage];
+};
+} // namespace cui
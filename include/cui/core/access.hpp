@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <type_traits>
+#include <utility>
 #include <cui/core/node.hpp>
 #include <cui/core/rect.hpp>
 #include <cui/core/vector.hpp>
@@ -89,6 +91,66 @@ public:
     node.paint(canvas);
   }
 
+  /// \copydoc Container::onLayoutBegin
+  ///
+  /// Calls the method of a final node type directly if it is accessible.
+  template <typename T>
+  static void onLayoutBegin(T& child, Context& context) noexcept {
+    if constexpr (is_direct<T, layout_begin_t>::value) {
+      child.onLayoutBegin(context);
+    } else {
+      onLayoutBegin(static_cast<Container&>(child), context);
+    }
+  }
+
+  /// \copydoc Container::onLayoutConstrain
+  ///
+  /// Calls the method of a final node type directly if it is accessible.
+  template <typename T>
+  static Constraints onChildConstrain(T& parent, Node& child) noexcept {
+    if constexpr (is_direct<T, layout_constrain_t>::value) {
+      return parent.onLayoutConstrain(child);
+    } else {
+      return onChildConstrain(static_cast<Container&>(parent), child);
+    }
+  }
+
+  /// \copydoc Container::onLayoutEnd
+  ///
+  /// Calls the method of a final node type directly if it is accessible.
+  template <typename T>
+  static Vec2 onLayoutEnd(T& container, Context& context) noexcept {
+    if constexpr (is_direct<T, layout_end_t>::value) {
+      return container.onLayoutEnd(context);
+    } else {
+      return onLayoutEnd(static_cast<Container&>(container), context);
+    }
+  }
+
+  /// \copydoc Widget::preferredSize
+  ///
+  /// Calls the method of a final node type directly if it is accessible.
+  template <typename T>
+  static Vec2 preferredSize(T const& node, Context& context) noexcept {
+    if constexpr (is_direct<T, preferred_size_t>::value) {
+      return node.preferredSize(context);
+    } else {
+      return static_cast<Widget const&>(node).preferredSize(context);
+    }
+  }
+
+  /// \copydoc Widget::paint
+  ///
+  /// Calls the method of a final node type directly if it is accessible.
+  template <typename T>
+  static void paint(T const& node, Canvas& canvas) noexcept {
+    if constexpr (is_direct<T, paint_t>::value) {
+      node.paint(canvas);
+    } else {
+      paint(static_cast<Widget const&>(node), canvas);
+    }
+  }
+
   static void setLayoutDirty(Node& node) noexcept {
     node.flags_ |= Node::LayoutDirty;
   }
@@ -100,8 +162,17 @@ public:
   }
 
   static void clearPaintDirty(Node& node) noexcept {
+    if (Widget* widget = dyn_cast<Widget>(node)) {
+      widget->flags_ &= ~Widget::PaintDamaged;
+      widget->damage_ = Rect{};
+    }
+
     node.flags_ &= ~(Node::PaintDirty | Node::PaintRepositioned |
-                     Node::PaintChildDirty | Node::PaintChildDirtyDiverged);
+                     Node::PaintMoved | Node::PaintChildDirty |
+                     Node::PaintChildDirtyDiverged);
+  }
+  static void clearChildScrolled(Node& node) noexcept {
+    node.flags_ &= ~Node::PaintChildScrolled;
   }
 
   static void setSharesParentLifetime(Node& node) noexcept {
@@ -126,5 +197,30 @@ public:
   isSharingParentLifetime(Node const& node) noexcept {
     return node.has(Node::Flag::SharesParentLifetime);
   }
+
+private:
+  template <typename T>
+  using layout_begin_t = decltype(std::declval<T&>().onLayoutBegin(
+      std::declval<Context&>()));
+  template <typename T>
+  using layout_constrain_t = decltype(std::declval<T&>().onLayoutConstrain(
+      std::declval<Node&>()));
+  template <typename T>
+  using layout_end_t = decltype(std::declval<T&>().onLayoutEnd(
+      std::declval<Context&>()));
+  template <typename T>
+  using preferred_size_t = decltype(std::declval<T const&>().preferredSize(
+      std::declval<Context&>()));
+  template <typename T>
+  using paint_t = decltype(std::declval<T const&>().paint(
+      std::declval<Canvas&>()));
+
+  // A method can be called without a virtual dispatch if the node type is
+  // final and the method is accessible from here (overrides become accessible
+  // if the node type declares NodeAccess as friend).
+  template <typename T, template <typename> class Method, typename = void>
+  struct is_direct : std::false_type {};
+  template <typename T, template <typename> class Method>
+  struct is_direct<T, Method, std::void_t<Method<T>>> : std::is_final<T> {};
 };
 } // namespace cui
@@ -20,13 +20,17 @@
 
 #pragma once
 
+#include <cstddef>
+#include <utility>
 #include <cui/core/component.hpp>
 #include <cui/core/detail/algorithm_impl.hpp>
+#include <cui/core/node.hpp>
 #include <cui/core/rect.hpp>
 #include <cui/core/vector.hpp>
 #include <cui/fwd.hpp>
 #include <cui/util/casting.hpp>
 #include <cui/util/common.h>
+#include <cui/util/span.hpp>
 #include <cui/util/type_of.hpp>
 
 namespace cui {
@@ -71,13 +75,89 @@ CUI_API bool is_transitive_parent(Node& parent, Node& child) noexcept;
 
 /// Returns the deepest Node located at the given position
 ///
+/// Uses the SpatialIndex of the given Node if there is one, otherwise the
+/// tree is traversed along the clip spaces of the last paint.
+///
 /// \attention This function can return a nullptr if no Node is located
 ///            at the given position!
 CUI_API Node const* intersection(Node const& node, Vec2 position) noexcept;
 
 /// Returns true if the Node collides with any of its visible siblings
+///
+/// Uses the SiblingOrder of the parent if there is one, otherwise all
+/// siblings are compared.
 CUI_API bool collides(Node const& node) noexcept;
 
+/// Returns true if the visible parts of both sibling Nodes collide
+CUI_API bool collides(Node const& left, Node const& right) noexcept;
+
+namespace detail {
+/// Returns the up to date children of the SiblingOrder attached to the
+/// Container or an empty Span if there is none
+CUI_API Span<Node const* const>
+sibling_order(Container const& container) noexcept;
+
+/// Sorts the children of the Container into the storage by their left edge
+///
+/// \returns the count of children, which exceeds the size of the storage
+///          if it can't hold all children.
+CUI_API std::size_t sort_children(Container const& container,
+                                  Span<Node const*> storage) noexcept;
+
+/// Invokes the visitor with every pair of colliding Nodes of the given
+/// siblings, which are sorted by their left edge
+template <typename T>
+void sweep(Span<Node const* const> order, T&& visitor) noexcept {
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    Node const& left = *order[i];
+    Point const end = left.area().high.x;
+
+    // Only siblings starting before the right edge can overlap
+    for (std::size_t j = i + 1;
+         (j < order.size()) && (order[j]->area().low.x <= end); ++j) {
+      if (collides(left, *order[j])) {
+        visitor(left, *order[j]);
+      }
+    }
+  }
+}
+} // namespace detail
+
+/// Invokes the visitor with every pair of visible children of the Container
+/// that collide with each other:
+///
+/// ```cpp
+/// Node const* storage[64];
+/// collisions(container, storage, [](Node const& left, Node const& right) {
+///   // ...
+/// });
+/// ```
+///
+/// The children are sorted by their left edge and swept from left to right,
+/// thus only children that overlap horizontally are compared. The sorted
+/// order of a SiblingOrder attached to the Container is reused if present,
+/// the storage is used otherwise.
+///
+/// \returns false if the storage can't hold all children,
+///          no pair is visited then.
+template <typename T>
+bool collisions(Container const& container, Span<Node const*> storage,
+                T&& visitor) noexcept {
+  if (auto const order = detail::sibling_order(container); !order.empty()) {
+    detail::sweep(order, std::forward<T>(visitor));
+    return true;
+  }
+
+  std::size_t const size = detail::sort_children(container, storage);
+  if (size > storage.size()) {
+    return false;
+  }
+
+  detail::sweep(Span<Node const* const>(storage.data(), size),
+                std::forward<T>(visitor));
+  return true;
+}
+
 /// Attempts to find a component of the given type,
 /// that is attached to the given Node
 ///
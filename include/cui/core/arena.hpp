@@ -0,0 +1,147 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/span.hpp>
+
+namespace cui {
+/// Mirrors a tree of Nodes into contiguous struct-of-arrays storage, which
+/// makes traversals stream linearly through memory instead of chasing the
+/// child and sibling pointers of the Nodes.
+///
+/// The Nodes are stored in pre-order. Every Node refers to its parent and the
+/// end of its subtree by index, thus the children of a Node can be skipped
+/// by jumping to its end. The absolute bounds and clip spaces of the Nodes
+/// are kept in separate columns which are recomputed by \see refresh.
+///
+/// The arena is a snapshot of the tree, it has to be reassigned when Nodes
+/// are inserted, erased or moved.
+///
+/// ```cpp
+/// NodeArena::Index parents[1024], ends[1024];
+/// Node* nodes[1024];
+/// Rect bounds[1024], clips[1024];
+///
+/// NodeArena arena(nodes, parents, ends, bounds, clips);
+/// arena.assign(root);
+/// arena.refresh();
+/// ```
+class CUI_API NodeArena {
+public:
+  using Index = std::uint32_t;
+
+  /// The parent index of the root
+  static constexpr Index npos = static_cast<Index>(-1);
+
+  explicit NodeArena(Span<Node*> nodes, Span<Index> parents, Span<Index> ends,
+                     Span<Rect> bounds, Span<Rect> clips) noexcept;
+
+  /// Flattens the tree of the given root into the arena
+  ///
+  /// \returns false if the capacity of the arena was exceeded, the arena is
+  ///          empty then.
+  bool assign(Node& root) noexcept;
+
+  /// Empties the arena
+  void clear() noexcept;
+
+  /// Recomputes the absolute bounds and clip spaces of all Nodes in a single
+  /// linear pass and stores the clip spaces in the Nodes.
+  ///
+  /// \attention The tree has to be layouted.
+  void refresh() noexcept;
+
+  /// Returns the index of the deepest Node located at the given position
+  /// or npos if no Node is located at it.
+  ///
+  /// Equivalent to cui::intersection, requires an up to date \see refresh.
+  [[nodiscard]] Index intersection(Vec2 position) const noexcept;
+
+  /// Returns the count of stored Nodes
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+  /// Returns the count of Nodes that fit into the arena
+  [[nodiscard]] constexpr std::size_t capacity() const noexcept {
+    return nodes_.size();
+  }
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns all stored Nodes in pre-order
+  [[nodiscard]] constexpr Span<Node* const> nodes() const noexcept {
+    return {nodes_.data(), size_};
+  }
+
+  [[nodiscard]] constexpr Node& node(Index index) const noexcept {
+    return *nodes_[index];
+  }
+  /// Returns the index of the parent or npos for the root
+  [[nodiscard]] constexpr Index parent(Index index) const noexcept {
+    return parents_[index];
+  }
+  /// Returns the index after the last Node of the subtree
+  [[nodiscard]] constexpr Index end(Index index) const noexcept {
+    return ends_[index];
+  }
+  /// Returns the absolute, unclipped area of the Node
+  [[nodiscard]] constexpr Rect const& bounds(Index index) const noexcept {
+    return bounds_[index];
+  }
+  /// Returns the absolute clip space of the Node
+  [[nodiscard]] constexpr Rect const& clip(Index index) const noexcept {
+    return clips_[index];
+  }
+
+private:
+  Span<Node*> nodes_;
+  Span<Index> parents_;
+  Span<Index> ends_;
+  Span<Rect> bounds_;
+  Span<Rect> clips_;
+  std::size_t size_{0};
+};
+
+/// A NodeArena that stores up to Capacity Nodes inside itself
+template <std::size_t Capacity>
+class BasicNodeArena final : public NodeArena {
+public:
+  BasicNodeArena() noexcept
+    : NodeArena(nodes_, parents_, ends_, bounds_, clips_) {}
+
+  BasicNodeArena(BasicNodeArena const&) = delete;
+  BasicNodeArena& operator=(BasicNodeArena const&) = delete;
+
+private:
+  Node* nodes_[Capacity];
+  Index parents_[Capacity];
+  Index ends_[Capacity];
+  Rect bounds_[Capacity];
+  Rect clips_[Capacity];
+};
+} // namespace cui
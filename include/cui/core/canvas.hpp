@@ -21,6 +21,7 @@
 #pragma once
 
 #include <string_view>
+#include <type_traits>
 #include <cui/core/color.hpp>
 #include <cui/core/paint.hpp>
 #include <cui/core/rect.hpp>
@@ -48,6 +49,11 @@ public:
     return surface_->stringBounds(str);
   }
 
+  /// Returns the horizontal advance of the given glyph, or 0 if unknown
+  [[nodiscard, gnu::always_inline]] Point glyphAdvance(char glyph) noexcept {
+    return surface_->glyphAdvance(glyph);
+  }
+
 protected:
   Surface* surface_;
 };
@@ -146,4 +152,80 @@ private:
   Vec2 translation_;
   Rect clip_;
 };
+
+/// Describes a Canvas that dispatches its draw calls statically to a known
+/// final Surface type, which allows the compiler to devirtualize and inline
+/// the draw calls of a Widget.
+///
+/// The paint pipeline creates a BasicCanvas whenever it is invoked with a
+/// final Surface type, Widgets can receive it through a PaintComponent.
+template <typename SurfaceT>
+class BasicCanvas final : public Canvas {
+  static_assert(std::is_base_of_v<Surface, SurfaceT>,
+                "Requires a type derived from Surface!");
+
+public:
+  explicit BasicCanvas(SurfaceT& surface, Vec2 translation,
+                       Rect const& clip) noexcept
+    : Canvas(surface, translation, clip) {}
+
+  [[nodiscard, gnu::always_inline]] Vec2 resolution() const noexcept {
+    return surface().resolution();
+  }
+
+  [[nodiscard, gnu::always_inline]] Vec2
+  stringBounds(std::string_view str) noexcept {
+    return surface().stringBounds(str);
+  }
+
+  [[nodiscard, gnu::always_inline]] Point glyphAdvance(char glyph) noexcept {
+    return surface().glyphAdvance(glyph);
+  }
+
+  [[gnu::always_inline]] void
+  drawPoint(Vec2 position, Paint const& paint = Paint::empty()) noexcept {
+    surface().drawPoint(position, paint);
+  }
+
+  [[gnu::always_inline]] void
+  drawLine(Vec2 from, Vec2 to, Paint const& paint = Paint::empty()) noexcept {
+    surface().drawLine(from, to, paint);
+  }
+
+  [[gnu::always_inline]] void
+  drawRect(Rect const& rect, Paint const& paint = Paint::empty()) noexcept {
+    surface().drawRect(rect, paint);
+  }
+
+  [[gnu::always_inline]] void
+  drawCircle(Vec2 position, Point radius,
+             Paint const& paint = Paint::empty()) noexcept {
+    surface().drawCircle(position, radius, paint);
+  }
+
+  [[gnu::always_inline]] void
+  drawImage(Rect const& area, Span<std::uint16_t const> image) noexcept {
+    surface().drawImage(area, image);
+  }
+
+  [[gnu::always_inline]] void
+  drawBitImage(Rect const& area, Span<std::uint8_t const> image,
+               Paint const& imbue = Paint::empty()) noexcept {
+    surface().drawBitImage(area, image, imbue);
+  }
+
+  [[gnu::always_inline]] void
+  drawText(Vec2 position, std::string_view str,
+           Paint const& paint = Paint::empty()) noexcept {
+    surface().drawText(position, str, paint);
+  }
+
+  /// Returns the statically typed Surface
+  [[nodiscard, gnu::always_inline]] SurfaceT& surface() noexcept {
+    return static_cast<SurfaceT&>(*surface_);
+  }
+  [[nodiscard, gnu::always_inline]] SurfaceT const& surface() const noexcept {
+    return static_cast<SurfaceT const&>(*surface_);
+  }
+};
 } // namespace cui
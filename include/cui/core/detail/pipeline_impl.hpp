@@ -20,8 +20,16 @@
 
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+#include <cui/component/layer.hpp>
+#include <cui/component/paint.hpp>
+#include <cui/component/scroll.hpp>
+#include <cui/component/traversal.hpp>
+#include <cui/component/worklist.hpp>
 #include <cui/core/access.hpp>
 #include <cui/core/algorithm.hpp>
+#include <cui/core/arena.hpp>
 #include <cui/core/canvas.hpp>
 #include <cui/core/node.hpp>
 #include <cui/core/rect.hpp>
@@ -32,22 +40,263 @@
 #include <cui/util/common.h>
 
 namespace cui::detail {
+/// Layouts the given Node and its children with the constraints the Node
+/// already has and returns true if the size of the Node has changed.
+///
+/// The size of a root Node is always set to its constraints.
+CUI_API bool layout_nodes(Context& context, Node& node, bool root) noexcept;
+
+/// Paints the Widget, dispatching the draw calls statically if possible
+template <typename Surface, typename T = Widget>
+void paint_widget(T const& widget, Surface& surface, Vec2 translation,
+                  Rect const& clip) noexcept {
+  if constexpr (std::is_final_v<Surface>) {
+    BasicCanvas<Surface> canvas(surface, translation, clip);
+
+    if (auto const hook = any<PaintComponent<Surface>>(widget)) {
+      (*hook)(canvas);
+    } else {
+      NodeAccess::paint(widget, canvas);
+    }
+  } else {
+    Canvas canvas(surface, translation, clip);
+
+    NodeAccess::paint(widget, canvas);
+  }
+}
+
+/// Returns true if the visible area of the Node is covered entirely by an
+/// opaque sibling that is painted after it
+///
+/// The translation is the absolute translation of the Node itself.
+inline bool occluded(Node const& node, Rect const& visible,
+                     Vec2 translation) noexcept {
+  Container const* const parent = node.parent();
+  if (!parent || !parent->isChildOpaque()) {
+    return false;
+  }
+
+  Vec2 const origin = translation - node.area().low;
+
+  // The siblings of a Node start with the Node itself
+  for (Node const& sibling : node.siblings()) {
+    if ((&sibling != &node) && sibling.isOpaque() &&
+        (sibling.area() + origin).contains(visible)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Returns true if the visible area of the Node is covered entirely by an
+/// opaque sibling of the Node or of any of its parents
+inline bool occluded_path(Node const& node, Rect const& visible,
+                          Vec2 translation) noexcept {
+  for (Node const* current = &node; current->parent();
+       current = current->parent()) {
+    if (occluded(*current, visible, translation)) {
+      return true;
+    }
+
+    translation -= current->area().low;
+  }
+  return false;
+}
+
+/// Keeps the opaque Nodes that are painted after the Nodes on the current
+/// path of a traversal, and thus may cover the currently visited Node.
+///
+/// The opaque children of a Container are collected once when it is entered,
+/// in reverse order, such that the next opaque child is always on top.
+/// Entries are dropped when their Node is visited or their Container is left.
+/// Opaque Nodes that don't fit into the stack are not considered, which only
+/// paints more than necessary.
+class OcclusionStack {
+public:
+  static constexpr std::size_t capacity = 8;
+
+  /// Collects the opaque children of the Container which overlap the area,
+  /// the translation is the absolute translation of the Container
+  void enter(Container const& container, Vec2 translation,
+             Rect const& area) noexcept {
+    push(container, nullptr, translation, area);
+  }
+
+  /// Collects the opaque siblings that follow the Node or any of its parents,
+  /// the translation is the absolute translation of the parent of the Node
+  void enterParents(Node const& node, Vec2 translation,
+                    Rect const& area) noexcept {
+    Node const* current = &node;
+    while (Container const* const parent = current->parent()) {
+      push(*parent, current, translation, area);
+
+      translation -= parent->area().low;
+      current = parent;
+    }
+  }
+
+  /// Drops the entry of the visited Node since it can't cover itself
+  void visit(Node const& node) noexcept {
+    if (size_ && (entries_[size_ - 1].node == &node)) {
+      --size_;
+    }
+  }
+
+  /// Drops the remaining entries of the left Container
+  void leave(Container const& container) noexcept {
+    while (size_ && (entries_[size_ - 1].node->parent() == &container)) {
+      --size_;
+    }
+  }
+
+  /// Returns true if the visible area is covered entirely by an opaque Node
+  [[nodiscard]] bool occluded(Rect const& visible) const noexcept {
+    for (std::size_t i = 0; i < size_; ++i) {
+      if (entries_[i].area.contains(visible)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  struct Entry {
+    Node const* node;
+    // The absolute area of the Node
+    Rect area;
+  };
+
+  /// Pushes the opaque children of the Container back to front until the
+  /// given child is reached
+  void push(Container const& container, Node const* until, Vec2 translation,
+            Rect const& area) noexcept {
+    if (!container.isChildOpaque()) {
+      return;
+    }
+
+    for (Node::const_iterator itr{&container.back()};
+         (itr != Node::const_iterator{}) && (&*itr != until); --itr) {
+      if (!itr->isOpaque()) {
+        continue;
+      }
+
+      Rect const cover = itr->area() + translation;
+      if (!Rect::ofIntersect(cover, area)) {
+        continue;
+      }
+
+      if (size_ == capacity) {
+        return;
+      }
+      entries_[size_++] = {&*itr, cover};
+    }
+  }
+
+  Entry entries_[capacity];
+  std::size_t size_{0};
+};
+
+/// Skips the subtree of a Node that is hidden behind an opaque sibling
+template <bool ClearFlags>
+void skip_occluded(Node& node) noexcept {
+  if constexpr (ClearFlags) {
+    Container const* const container = dyn_cast<Container>(node);
+
+    // Hidden Nodes are painted again when they are uncovered
+    if (node.isPaintDirty() || (container && container->isChildPaintDirty())) {
+      for (Node& current : visit(node)) {
+        NodeAccess::clearPaintDirty(current);
+      }
+    }
+  } else {
+    (void)node;
+  }
+}
+
+/// Composites the retained layer of the given Node if it has one
+///
+/// \returns false if the children of the Node have to be painted instead
 template <bool ClearFlags, typename Surface>
-void paint_impl(Node& node, Surface& surface, Rect const& window,
-                PositionRebuilder stack = {}) noexcept {
-  surface.begin(window);
+bool paint_layer(Node& node, Surface& surface, Vec2 translation,
+                 Rect const& visible, Rect const& clip) noexcept {
+  if (!node.contains(type_of<LayerComponent>())) {
+    return false;
+  }
+
+  auto& layer = static_cast<LayerComponent&>(
+      *node.find(type_of<LayerComponent>()));
+
+  if (!layer.prepare(surface, translation, visible)) {
+    return false;
+  }
+
+  layer.composite(surface, translation, clip);
+
+  if constexpr (ClearFlags) {
+    if (node.isPaintDirty() || cast<Container>(node).isChildPaintDirty()) {
+      for (Node& current : visit(node)) {
+        NodeAccess::clearPaintDirty(current);
+      }
+    }
+  }
+  return true;
+}
+
+/// Marks the displayed content of a scrolled Container as up to date if the
+/// window repaints its whole visible area
+template <typename Surface>
+void settle_scroll(Node& node, Surface& surface, Rect const& window,
+                   Rect const& visible) noexcept {
+  if (ScrollComponent* const scroll = any<ScrollComponent>(node)) {
+    if (window.contains(
+            Rect::ofIntersect(visible, Rect::with(surface.resolution())))) {
+      scroll->settle();
+    } else if (scroll->isPending()) {
+      // The content was partially repainted and can't be shifted anymore
+      scroll->invalidate();
+    }
+  }
+}
+
+/// Paints the given Node and its children into the current window
+template <bool ClearFlags, typename Surface>
+void paint_nodes(Node& node, Surface& surface, Rect const& window,
+                 PositionRebuilder& stack) noexcept {
+  OcclusionStack occluders;
+  occluders.enterParents(node, stack.translation(), window);
 
   for (Accept& current : traverse(node)) {
     if (current.isPre()) {
+      occluders.visit(*current);
       stack.push(*current);
 
       if (Rect const clip = Rect::ofIntersect(window, stack.clip())) {
+        if (occluders.occluded(clip)) {
+          skip_occluded<ClearFlags>(*current);
+
+          stack.pop(*current);
+          current.skip();
+          continue;
+        }
+
         if (Widget const* widget = dyn_cast<Widget>(*current)) {
           CUI_ASSERT(current.isLeaf());
 
-          Canvas canvas(surface, stack.translation(), clip);
+          paint_widget(*widget, surface, stack.translation(), clip);
+        } else {
+          if constexpr (ClearFlags) {
+            settle_scroll(*current, surface, window, stack.clip());
+          }
+
+          if (paint_layer<ClearFlags>(*current, surface, stack.translation(),
+                                      stack.clip(), clip)) {
+            stack.pop(*current);
+            current.skip();
+            continue;
+          }
 
-          NodeAccess::paint(*widget, canvas);
+          occluders.enter(cast<Container>(*current), stack.translation(),
+                          clip);
         }
       } else {
         // If the current area is not drawn skip every child
@@ -62,22 +311,110 @@ void paint_impl(Node& node, Surface& surface, Rect const& window,
         NodeAccess::clearPaintDirty(*current);
       }
 
+      if (Container const* const container = dyn_cast<Container>(*current)) {
+        occluders.leave(*container);
+      }
+
       stack.pop(*current);
     }
   }
+}
+
+/// Paints the flattened tree of the arena into the current window
+template <bool ClearFlags, typename Surface>
+void paint_arena_nodes(NodeArena& arena, Surface& surface,
+                       Rect const& window) noexcept {
+  OcclusionStack occluders;
+  NodeArena::Index current = 0;
+
+  // Continues with the given Node and leaves the Containers ending before it
+  auto const advance = [&](NodeArena::Index next) {
+    for (NodeArena::Index i = current;
+         (i != NodeArena::npos) && (arena.end(i) <= next);
+         i = arena.parent(i)) {
+      if (Container const* const container = dyn_cast<Container>(
+              arena.node(i))) {
+        occluders.leave(*container);
+      }
+    }
+    current = next;
+  };
+
+  while (current < arena.size()) {
+    Node& node = arena.node(current);
+    occluders.visit(node);
+
+    Rect const clip = Rect::ofIntersect(window, arena.clip(current));
+    if (!clip) {
+      // If the current area is not drawn skip every child
+      advance(arena.end(current));
+      continue;
+    }
+
+    if (occluders.occluded(clip)) {
+      skip_occluded<ClearFlags>(node);
+
+      advance(arena.end(current));
+      continue;
+    }
+
+    if (Widget const* widget = dyn_cast<Widget>(node)) {
+      paint_widget(*widget, surface, arena.bounds(current).low, clip);
+    } else {
+      if constexpr (ClearFlags) {
+        settle_scroll(node, surface, window, arena.clip(current));
+      }
+
+      if (paint_layer<ClearFlags>(node, surface, arena.bounds(current).low,
+                                  arena.clip(current), clip)) {
+        advance(arena.end(current));
+        continue;
+      }
+
+      occluders.enter(cast<Container>(node), arena.bounds(current).low, clip);
+    }
+
+    if constexpr (ClearFlags) {
+      NodeAccess::clearPaintDirty(node);
+    }
+
+    advance(current + 1);
+  }
+}
+
+template <bool ClearFlags, typename Surface>
+void paint_impl(Node& node, Surface& surface, Rect const& window,
+                PositionRebuilder stack = {}) noexcept {
+  surface.begin(window);
+
+  // Trees painted from their root can be walked through their arena
+  TraversalCache* const cache = node.isRoot() ? any<TraversalCache>(node)
+                                              : nullptr;
+  if (NodeArena* const arena = cache ? cache->arena() : nullptr) {
+    paint_arena_nodes<ClearFlags>(*arena, surface, window);
+  } else {
+    paint_nodes<ClearFlags>(node, surface, window, stack);
+  }
 
   surface.end();
 }
 
 template <typename Surface>
-Rect affected_area(Node const& current, Rect const& clip,
+Rect affected_area(Node const& current, Rect const& clip, Vec2 translation,
                    Surface const& surface) noexcept {
   if (current.isRoot() && current.isPaintRepositioned()) {
     // If the updated element is the root element we have to update the
     // whole display in case the element was moved
     return Rect::with(surface.resolution());
   } else {
-    Rect const ret = Rect::ofIntersect(clip, Rect::with(surface.resolution()));
+    Rect ret = Rect::ofIntersect(clip, Rect::with(surface.resolution()));
+
+    // Widgets with a limited repaint only update their damaged area
+    Widget const* const widget = dyn_cast<Widget>(current);
+    if (widget && widget->isPaintDamaged()) {
+      ret = Rect::ofIntersect(ret, widget->damage() + translation);
+    }
+
     CUI_ASSERT(Rect::with(surface.resolution()).contains(ret));
     return ret;
   }
@@ -104,38 +441,37 @@ void paint_into(Surface& surface, Node& root, Node& current, Rect const& clip,
   }
 }
 
+/// Partially paints the given Node and its children which are part of
+/// the given root Node tree
 template <typename Surface>
-void paint_partial_impl(Node& node, Surface& surface) noexcept {
-  // 1. Summarize paint calls across siblings together into
-  //    the same area
-  // 2. If that does not fit into one buffer paint every sibling
-  //    one after another
-  // 3. If one container does not fit into one buffer split
-  //    according to 1.
-  // 4. If one Widget does not fit into one buffer paint it per
-  //    multiple lines
-  //    - Minimizes paint calls and maximizes rasterization
-  //      pipeline outcome
-  bool updated = false;
-  PositionRebuilder stack;
+void paint_partial_nodes(Node& root, Node& node, Surface& surface,
+                         PositionRebuilder& stack, bool& updated) noexcept {
+  OcclusionStack occluders;
+  occluders.enterParents(node, stack.translation(), Rect::all());
 
   for (Accept& current : traverse(node)) {
     if (current.isPre()) {
+      occluders.visit(*current);
       stack.push(*current);
 
       if (Rect const clip = stack.clip()) {
         if (current->isPaintDirty()) {
-          Rect remaining = affected_area(*current, clip, surface);
+          Rect remaining = affected_area(*current, clip, stack.translation(),
+                                         surface);
 
-          while (remaining) {
-            Rect const split = surface.split(remaining);
-            CUI_ASSERT(split); // No progress has been made!
+          if (occluders.occluded(remaining)) {
+            skip_occluded<true>(*current);
+          } else {
+            while (remaining) {
+              Rect const split = surface.split(remaining);
+              CUI_ASSERT(split); // No progress has been made!
 
-            paint_into(surface, node, *current, clip, split, stack);
-          }
+              paint_into(surface, root, *current, clip, split, stack);
+            }
 
-          updated = true;
-          NodeAccess::clearPaintDirty(*current);
+            updated = true;
+            NodeAccess::clearPaintDirty(*current);
+          }
 
           stack.pop(*current);
           current.skip();
@@ -148,15 +484,20 @@ void paint_partial_impl(Node& node, Surface& surface) noexcept {
           current.skip();
           continue;
         } else if (container->isChildPaintDirtyDiverged()) {
-          Rect remaining = affected_area(*current, clip, surface);
+          Rect remaining = affected_area(*current, clip, stack.translation(),
+                                         surface);
           Rect const split = surface.split(remaining);
 
           if (!remaining) {
-            // We can draw the whole container inside the window
-            paint_into(surface, node, *current, clip, split, stack);
+            if (occluders.occluded(split)) {
+              skip_occluded<true>(*current);
+            } else {
+              // We can draw the whole container inside the window
+              paint_into(surface, root, *current, clip, split, stack);
 
-            updated = true;
-            NodeAccess::clearPaintDirty(*current);
+              updated = true;
+              NodeAccess::clearPaintDirty(*current);
+            }
 
             stack.pop(*current);
             current.skip();
@@ -165,6 +506,8 @@ void paint_partial_impl(Node& node, Surface& surface) noexcept {
 
           // Otherwise descend further
         }
+
+        occluders.enter(*container, stack.translation(), clip);
       } else {
         // If the current area is not drawn skip every child
         stack.pop(*current);
@@ -175,9 +518,234 @@ void paint_partial_impl(Node& node, Surface& surface) noexcept {
 
     if (current.isPost()) {
       NodeAccess::clearPaintDirty(*current);
+
+      if (Container const* const container = dyn_cast<Container>(*current)) {
+        occluders.leave(*container);
+      }
+
+      stack.pop(*current);
+    }
+  }
+}
+
+/// Shifts the displayed content of a scrolled Container and paints the
+/// strips of its visible area that were exposed by the shift
+template <typename Surface>
+void scroll_into(Surface& surface, Container& container,
+                 ScrollComponent& scroll, Rect const& clip,
+                 PositionRebuilder const& stack) noexcept {
+  Rect const area = Rect::ofIntersect(clip, Rect::with(surface.resolution()));
+
+  Rect strips[2];
+  std::size_t count = ScrollComponent::exposed(area, scroll.pending(), strips);
+
+  if (scroll.isInvalid() || (strips[0] == area) ||
+      !surface.scroll(area, scroll.pending())) {
+    strips[0] = area;
+    count = 1;
+  }
+
+  PositionRebuilder baseline = stack;
+  baseline.pop(container);
+
+  // The paint state is left untouched because only parts of the children
+  // are painted, dirty children are repainted by the following traversal.
+  for (std::size_t i = 0; i < count; ++i) {
+    Rect remaining = strips[i];
+
+    while (remaining) {
+      Rect const split = surface.split(remaining);
+      CUI_ASSERT(split); // No progress has been made!
+
+      paint_impl<false>(container, surface, split, baseline);
+    }
+  }
+
+  scroll.settle();
+}
+
+/// Shifts the displayed content of every scrolled Container of the tree,
+/// which happens before any other Node is painted in the current pass.
+template <typename Surface>
+void scroll_nodes(Node& root, Surface& surface, bool& updated) noexcept {
+  PositionRebuilder stack;
+
+  for (Accept& current : traverse(root)) {
+    if (current.isPre()) {
+      stack.push(*current);
+
+      Container* const container = dyn_cast<Container>(*current);
+      if (!container || !container->isChildScrolled()) {
+        stack.pop(*current);
+        current.skip();
+        continue;
+      }
+
+      NodeAccess::clearChildScrolled(*container);
+
+      // Dirty Containers are painted entirely by the traversal
+      Rect const clip = stack.clip();
+      if (container->isPaintDirty() || !clip) {
+        stack.pop(*current);
+        current.skip();
+        continue;
+      }
+
+      // Hidden content can't be shifted, it is painted when uncovered
+      if (occluded(*container, clip, stack.translation())) {
+        for (Node& hidden : visit(*container)) {
+          ScrollComponent* const scroll = any<ScrollComponent>(hidden);
+          if (scroll && scroll->isPending()) {
+            scroll->invalidate();
+          }
+          NodeAccess::clearChildScrolled(hidden);
+        }
+
+        stack.pop(*current);
+        current.skip();
+        continue;
+      }
+
+      if (ScrollComponent* const scroll = any<ScrollComponent>(*container)) {
+        if (scroll->isPending()) {
+          scroll_into(surface, *container, *scroll, clip, stack);
+          updated = true;
+        }
+      }
+    }
+
+    if (current.isPost()) {
       stack.pop(*current);
     }
   }
+}
+
+/// Pushes the given Node and all of its parents on the stack
+inline void push_parents(PositionRebuilder& stack, Node& node) noexcept {
+  if (Container* const parent = node.parent()) {
+    push_parents(stack, *parent);
+  }
+
+  stack.push(node);
+}
+
+/// Partially paints the Nodes listed in the worklist of the given root
+template <typename Surface>
+void paint_worklist_nodes(Node& root, PaintWorklistBase const& worklist,
+                          Surface& surface, bool& updated) noexcept {
+  for (Node* const current : worklist.entries()) {
+    if (!current->isPaintDirty()) {
+      // Already painted together with a listed parent
+      continue;
+    }
+
+    bool covered = false;
+    for (Container const& parent : parents(*current)) {
+      if (parent.isPaintDirty()) {
+        // The parent is listed as well and paints this Node
+        covered = true;
+        break;
+      }
+    }
+    if (covered) {
+      continue;
+    }
+
+    PositionRebuilder stack;
+    push_parents(stack, *current);
+
+    if (Rect const clip = stack.clip()) {
+      Rect remaining = affected_area(*current, clip, stack.translation(),
+                                     surface);
+
+      if (occluded_path(*current, remaining, stack.translation())) {
+        skip_occluded<true>(*current);
+        continue;
+      }
+
+      while (remaining) {
+        Rect const split = surface.split(remaining);
+        CUI_ASSERT(split); // No progress has been made!
+
+        paint_into(surface, root, *current, clip, split, stack);
+      }
+
+      updated = true;
+      NodeAccess::clearPaintDirty(*current);
+    }
+  }
+
+  // Reset the child paint state which the traversal would have reset
+  for (Node* const current : worklist.entries()) {
+    for (Container& parent : parents(*current)) {
+      if (!parent.isPaintDirty()) {
+        NodeAccess::clearPaintDirty(parent);
+      }
+    }
+  }
+}
+
+/// Paints the areas vacated by moved Nodes from the root
+template <typename Surface>
+void paint_damage(Node& root, PaintWorklistBase const& worklist,
+                  Surface& surface, bool& updated) noexcept {
+  // A dirty root is painted entirely anyway
+  if (root.isPaintDirty()) {
+    return;
+  }
+
+  for (Rect const& area : worklist.damage()) {
+    Rect remaining = Rect::ofIntersect(area, Rect::with(surface.resolution()));
+
+    // The paint state is left untouched because only parts of the Nodes
+    // are painted, the moved Nodes are painted by the following pass.
+    while (remaining) {
+      Rect const split = surface.split(remaining);
+      CUI_ASSERT(split); // No progress has been made!
+
+      paint_impl<false>(root, surface, split);
+      updated = true;
+    }
+  }
+}
+
+template <typename Surface>
+void paint_partial_impl(Node& node, Surface& surface) noexcept {
+  // 1. Summarize paint calls across siblings together into
+  //    the same area
+  // 2. If that does not fit into one buffer paint every sibling
+  //    one after another
+  // 3. If one container does not fit into one buffer split
+  //    according to 1.
+  // 4. If one Widget does not fit into one buffer paint it per
+  //    multiple lines
+  //    - Minimizes paint calls and maximizes rasterization
+  //      pipeline outcome
+  bool updated = false;
+
+  // Scrolled content is shifted first, so later paints are never moved
+  scroll_nodes(node, surface, updated);
+
+  // Roots with a complete worklist only visit the listed Nodes
+  PaintWorklistBase* const worklist = node.isRoot()
+                                          ? any<PaintWorklistBase>(node)
+                                          : nullptr;
+
+  // Areas vacated by moved Nodes are painted before the Nodes themselves
+  if (worklist) {
+    paint_damage(node, *worklist, surface, updated);
+  }
+
+  if (worklist && worklist->complete() && !node.isPaintDirty()) {
+    paint_worklist_nodes(node, *worklist, surface, updated);
+  } else {
+    PositionRebuilder stack;
+    paint_partial_nodes(node, node, surface, stack, updated);
+  }
+
+  if (worklist) {
+    worklist->clear();
+  }
 
   if (updated) {
     surface.flush();
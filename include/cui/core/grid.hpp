@@ -0,0 +1,153 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cui/core/arena.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/util/common.h>
+#include <cui/util/span.hpp>
+
+namespace cui {
+/// Implements a uniform grid over the absolute clip spaces of the Nodes
+/// stored in a NodeArena, which limits hit tests and area queries to the
+/// Nodes that overlap the cells at hand.
+///
+/// The clip space of the root is divided into a fixed count of columns and
+/// rows. Every cell lists the Nodes overlapping it in pre-order, which allows
+/// finding the deepest Node at a position in a single pass over one cell.
+///
+/// The grid is a snapshot of the arena, it has to be rebuilt after the arena
+/// was reassigned or refreshed.
+///
+/// ```cpp
+/// NodeArena::Index cells[8 * 8 + 1], entries[1024];
+///
+/// SpatialGrid grid(cells, entries, 8, 8);
+/// grid.build(arena);
+/// ```
+class CUI_API SpatialGrid {
+public:
+  using Index = NodeArena::Index;
+
+  explicit SpatialGrid(Span<Index> cells, Span<Index> entries,
+                       std::size_t columns, std::size_t rows) noexcept;
+
+  /// Sorts the Nodes of the given refreshed arena into the cells
+  ///
+  /// \returns false if the capacity of the entries was exceeded,
+  ///          the grid is invalid then.
+  bool build(NodeArena const& arena) noexcept;
+
+  /// Invalidates the grid
+  void clear() noexcept;
+
+  /// Returns the index of the deepest Node located at the given position
+  /// or npos if no Node is located at it.
+  ///
+  /// Equivalent to NodeArena::intersection, requires a valid grid.
+  [[nodiscard]] Index intersection(NodeArena const& arena,
+                                   Vec2 position) const noexcept;
+
+  /// Invokes the visitor with the index of every Node whose clip space
+  /// overlaps the given absolute area exactly once, requires a valid grid.
+  ///
+  /// \attention The Nodes are visited in the order of the cells,
+  ///            not in pre-order.
+  template <typename T>
+  void overlapping(NodeArena const& arena, Rect const& area,
+                   T&& visitor) const noexcept {
+    Rect const bounded = Rect::ofIntersect(area, bounds_);
+    if (bounded.empty()) {
+      return;
+    }
+
+    Rect const cells = range(bounded);
+
+    for (Point y = cells.low.y; y <= cells.high.y; ++y) {
+      for (Point x = cells.low.x; x <= cells.high.x; ++x) {
+        std::size_t const cell = index(Vec2{x, y});
+
+        for (Index i = cells_[cell]; i < cells_[cell + 1]; ++i) {
+          Index const entry = entries_[i];
+          Rect const clip = arena.clip(entry);
+
+          if (!clip.overlaps(area)) {
+            continue;
+          }
+
+          // Nodes spanning multiple cells are visited in their first one
+          Vec2 const first = max(range(clip).low, cells.low);
+          if ((first.x == x) && (first.y == y)) {
+            visitor(entry);
+          }
+        }
+      }
+    }
+  }
+
+  /// Returns true if the grid reflects the arena it was built from
+  [[nodiscard]] constexpr bool valid() const noexcept {
+    return valid_;
+  }
+
+  /// Returns the count of cell entries in use
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return valid_ ? cells_[columns_ * rows_] : 0;
+  }
+
+private:
+  /// Returns the indices of the cells covered by the given area
+  [[nodiscard]] Rect range(Rect const& area) const noexcept;
+
+  [[nodiscard]] constexpr std::size_t index(Vec2 cell) const noexcept {
+    return static_cast<std::size_t>(cell.y) * columns_ +
+           static_cast<std::size_t>(cell.x);
+  }
+
+  Span<Index> cells_;
+  Span<Index> entries_;
+  std::size_t columns_;
+  std::size_t rows_;
+  // The clip space of the root
+  Rect bounds_;
+  // The size of a single cell
+  Vec2 cell_;
+  bool valid_{false};
+};
+
+/// A SpatialGrid of Columns x Rows cells, which holds up to Entries
+/// cell entries inside itself
+template <std::size_t Columns, std::size_t Rows, std::size_t Entries>
+class BasicSpatialGrid final : public SpatialGrid {
+public:
+  BasicSpatialGrid() noexcept
+    : SpatialGrid(cells_, entries_, Columns, Rows) {}
+
+  BasicSpatialGrid(BasicSpatialGrid const&) = delete;
+  BasicSpatialGrid& operator=(BasicSpatialGrid const&) = delete;
+
+private:
+  Index cells_[Columns * Rows + 1];
+  Index entries_[Entries];
+};
+} // namespace cui
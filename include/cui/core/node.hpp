@@ -72,19 +72,34 @@ class CUI_API Node {
     PaintChildDirty = 0x0100,
     /// Is set when multiple children are PaintDirty possibly
     PaintChildDirtyDiverged = 0x0200,
+    /// Is set when the size of the Node always equals its constraints,
+    /// which stops size changes inside its subtree from reflowing its parents
+    RelayoutBoundary = 0x0400,
+    /// Is set when a child or the Container itself has a pending scroll,
+    /// \see ScrollComponent
+    PaintChildScrolled = 0x0800,
+
+    /// Is set when the Node covers its whole area opaquely when painted,
+    /// \see setOpaque
+    Opaque = 0x1000,
+    /// Is set when a child is or was opaque, which enables the occlusion
+    /// checks for the children of the Container
+    PaintChildOpaque = 0x2000,
+    /// Is set when the previously painted area of the moved Node was recorded
+    /// as damage on the worklist of its root, \see PaintWorklist
+    PaintMoved = 0x4000,
 
     // Specific flags for a Widget
+    /// Is set when the pending repaint of the Widget is limited to its
+    /// damaged area, \see Widget::repaint
+    PaintDamaged = 0x0200,
 
-    // Unused = 0x0200,
-    // Unused = 0x0400,
-    // Unused = 0x0800,
-    // Unused = 0x1000,
-    // Unused = 0x2000,
-    // Unused = 0x4000,
-    // Unused = 0x8000,
+    /// Is set when the parent defers the layout of this Node, which keeps
+    /// its dirty state until the parent clears it, \see Container::cull
+    LayoutCulled = 0x8000,
   };
 
-  using BloomFilter = TypeID;
+  using ComponentMask = std::uint64_t;
 
 public:
   enum class Kind : std::uint8_t { Container = 0, Widget = 1 };
@@ -154,6 +169,10 @@ public:
     return {const_iterator{this}, {}};
   }
 
+  /// Returns false if no Component with the given type is attached to this
+  /// Node, which is exact for dense TypeIDs (see dense_type_limit).
+  [[nodiscard]] bool contains(TypeID type) const noexcept;
+
   /// Returns the first component with the given type attached to this Node
   ///
   /// \attention The returned Component can be null, in case no Component
@@ -193,6 +212,10 @@ public:
   [[nodiscard]] constexpr bool isChildLayoutDirty() const noexcept {
     return has(LayoutChildDirty);
   }
+  /// Returns true if the layout of this Node is deferred by its parent
+  [[nodiscard]] constexpr bool isLayoutCulled() const noexcept {
+    return has(LayoutCulled);
+  }
   /// Returns true if a Node itself is paint dirty
   [[nodiscard]] constexpr bool isPaintDirty() const noexcept {
     return has(PaintDirty);
@@ -201,6 +224,14 @@ public:
   [[nodiscard]] constexpr bool isPaintRepositioned() const noexcept {
     return has(PaintRepositioned);
   }
+  /// Returns true if the Node absorbs the layout changes of its subtree
+  [[nodiscard]] constexpr bool isRelayoutBoundary() const noexcept {
+    return has(RelayoutBoundary);
+  }
+  /// Returns true if the Node covers its whole area opaquely when painted
+  [[nodiscard]] constexpr bool isOpaque() const noexcept {
+    return has(Opaque);
+  }
 
   /// Returns the relative display area of this Node to its parent
   [[nodiscard]] constexpr Rect const& area() const noexcept {
@@ -240,6 +271,24 @@ public:
   /// \copydetails setArea
   bool setSize(Vec2 size) noexcept;
 
+  /// Marks this Node as relayout boundary, which sizes it to its constraints
+  /// regardless of its children
+  ///
+  /// Children that change their size are layouted up to the boundary only,
+  /// instead of re-evaluating every parent up to the root. A boundary can
+  /// also be layouted alone through layout() without touching its parents.
+  void setRelayoutBoundary(bool boundary = true) noexcept;
+
+  /// Marks this Node as opaque, which hints that its paint covers its whole
+  /// area without any transparency
+  ///
+  /// Siblings painted before an opaque Node are skipped while painting
+  /// if the Node covers their visible area entirely.
+  ///
+  /// \attention Parts of the area that are not painted by the Node show
+  ///            outdated content of the covered siblings then.
+  void setOpaque(bool opaque = true) noexcept;
+
   /// Enables garbage collection of this Node
   constexpr void setGarbageCollected() noexcept {
     CUI_ASSERT(!has(GarbageCollected));
@@ -280,11 +329,12 @@ private:
 
   /// Specifies the offset to the first Component relative to this Node
   Component::Offset first_component_offset_{};
-  /// Specifies a bloom filter where the numeric TypeID of the attached
-  /// Component objects are hashed in, such that we can quickly check with a
+  /// Specifies a mask with an exact bit for every attached Component of a
+  /// dense TypeID and a bloom filter where the hashed TypeIDs of all other
+  /// Components are hashed in, such that we can quickly check with a
   /// complexity of O(1) if a Component is guaranteed not to be attached
   /// to this Node.
-  BloomFilter components_filter_{};
+  ComponentMask components_filter_{};
 
   /// Specifies the calculated (and cached) absolute display area of this Node
   ///
@@ -406,6 +456,15 @@ public:
   [[nodiscard]] constexpr bool isChildPaintDirtyDiverged() const noexcept {
     return has(PaintChildDirtyDiverged);
   }
+  /// Returns true if this Container or a Container inside it was scrolled
+  /// since the last partial paint
+  [[nodiscard]] constexpr bool isChildScrolled() const noexcept {
+    return has(PaintChildScrolled);
+  }
+  /// Returns true if a child of this Container is or was opaque
+  [[nodiscard]] constexpr bool isChildOpaque() const noexcept {
+    return has(PaintChildOpaque);
+  }
 
   static constexpr bool classof(Node const& self) noexcept {
     return self.kind() == Kind::Container;
@@ -437,6 +496,27 @@ protected:
   /// Layouts every children and returns the new size of the Container
   virtual Vec2 onLayoutEnd(Context& context) noexcept;
 
+  /// Moves every child by the given offset without a relayout
+  ///
+  /// The displayed content is shifted on the next partial paint if the
+  /// Container has a ScrollComponent, otherwise the Container is repainted.
+  void scroll(Vec2 offset) noexcept;
+
+  /// Moves a child whose displayed content was scrolled out of the visible
+  /// area to the given position and repaints it there
+  ///
+  /// Unlike Node::setPosition the area the child was painted at before is
+  /// not painted again, thus it must not be displayed anymore.
+  void recycle(Node& child, Vec2 position) noexcept;
+
+  /// Defers the layout of the given child until it is unculled again
+  ///
+  /// Culled children keep their constraints, area and dirty state while
+  /// this Container is laid out, and layout changes inside of them stop
+  /// at the child. Containers usually cull children outside of their
+  /// visible area and reflow themselves when a dirty child becomes visible.
+  void cull(Node& child, bool culled) noexcept;
+
 private:
   void repaint() noexcept;
 
@@ -472,6 +552,17 @@ public:
     return true;
   }
 
+  /// Returns true if only the damaged area of the Widget is repainted
+  [[nodiscard]] constexpr bool isPaintDamaged() const noexcept {
+    return has(PaintDamaged);
+  }
+  /// Returns the pending damage relative to the area of this Widget
+  ///
+  /// \attention The damage is only meaningful while \see isPaintDamaged
+  [[nodiscard]] constexpr Rect const& damage() const noexcept {
+    return damage_;
+  }
+
   [[nodiscard]] constexpr Widget& operator*() noexcept {
     return *this;
   }
@@ -489,8 +580,21 @@ protected:
   ///       the updated state anymore.
   void repaint() noexcept;
 
+  /// Set the given area of this node into a paint dirty state
+  ///
+  /// The area is relative to the area of this Widget and accumulated with
+  /// the previously damaged areas until the Widget is painted. Only the
+  /// damaged area is rasterized on a partial paint then.
+  ///
+  /// \note A pending repaint of the whole Widget is never limited.
+  void repaint(Rect const& area) noexcept;
+
   /// Paint this Node on the given canvas
   virtual void paint(Canvas& canvas) const noexcept;
+
+private:
+  // The pending damage which is relative to the area
+  Rect damage_;
 };
 
 template <>
@@ -20,10 +20,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cui/core/detail/pipeline_impl.hpp>
+#include <cui/core/node.hpp>
 #include <cui/core/rect.hpp>
 #include <cui/fwd.hpp>
 #include <cui/util/common.h>
+#include <cui/util/span.hpp>
 
 namespace cui {
 /// Resets the layout and draw state of the given node and causes a
@@ -33,6 +36,41 @@ CUI_API void reset(Node& node) noexcept;
 /// Layouts the given Node and its children
 CUI_API void layout(Node& node, Surface& surface) noexcept;
 
+/// Describes the layouted state of a single Node
+struct LayoutRecord {
+  Constraints constraints;
+  Rect area;
+  // The kind and the count of children of the captured Node, which identify
+  // the Node when the record is adopted
+  Node::Kind kind{Node::Kind::Container};
+  std::size_t children{0};
+};
+
+/// Captures the layout of the given Node and its children in pre-order into
+/// the given records and returns the count of Nodes inside the tree.
+///
+/// Nodes that exceed the size of the records are counted but not captured.
+CUI_API std::size_t capture_layout(Node const& node,
+                                   Span<LayoutRecord> records) noexcept;
+
+/// Adopts a layout that was previously captured from an identical Node tree
+/// instead of layouting it, which makes it possible to skip the layout before
+/// the first paint of static user interfaces:
+///
+/// ```cpp
+/// static constexpr LayoutRecord records[] = {...}; // Captured on the host
+///
+/// if (!adopt_layout(*root, surface, records)) {
+///   layout(*root, surface);
+/// }
+/// ```
+///
+/// Returns false and leaves the Node untouched if the count of Nodes, the kind
+/// or count of children of any Node or the resolution of the Surface do not
+/// match the records.
+CUI_API bool adopt_layout(Node& node, Surface& surface,
+                          Span<LayoutRecord const> records) noexcept;
+
 /// Paints all nodes on the given Surface without checking whether they
 /// need to be repainted and without touching their paint state.
 ///
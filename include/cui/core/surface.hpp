@@ -91,6 +91,16 @@ public:
   /// This method is called iteratively until the area is empty.
   virtual Rect split(Rect& area) const noexcept;
 
+  /// Shifts the displayed content inside the given area by the given offset
+  ///
+  /// Content that is shifted outside of the area is discarded, the part of
+  /// the area exposed by the shift has an undefined content afterwards and
+  /// is painted by the caller. This is never called between begin and end.
+  ///
+  /// \returns false if the Surface can't shift its displayed content, the
+  ///          whole area is painted again then.
+  virtual bool scroll(Rect const& area, Vec2 offset) noexcept;
+
   /// Draws a single point onto the Surface
   ///
   /// \note A point is usually mapped directly to a pixel on the Surface
@@ -122,6 +132,12 @@ public:
   /// Returns the bounds for the given string
   virtual Vec2 stringBounds(std::string_view str) noexcept = 0;
 
+  /// Returns the horizontal advance of the given glyph, which makes the
+  /// position of a glyph inside a single line string known.
+  ///
+  /// \returns 0 if the advance is unknown
+  virtual Point glyphAdvance(char glyph) noexcept;
+
   /// Returns the bounds for the given text glyph
   // virtual Vec2 glyphBounds(char32_t glyph) noexcept = 0;
 };
@@ -22,15 +22,26 @@
 
 #include <cui/component/animation.hpp>
 #include <cui/component/hook.hpp>
+#include <cui/component/index.hpp>
 #include <cui/component/input.hpp>
+#include <cui/component/layer.hpp>
 #include <cui/component/mount.hpp>
+#include <cui/component/order.hpp>
+#include <cui/component/paint.hpp>
 #include <cui/component/ref.hpp>
+#include <cui/component/registry.hpp>
+#include <cui/component/scroll.hpp>
+#include <cui/component/spatial.hpp>
+#include <cui/component/traversal.hpp>
+#include <cui/component/worklist.hpp>
 #include <cui/core/algorithm.hpp>
+#include <cui/core/arena.hpp>
 #include <cui/core/canvas.hpp>
 #include <cui/core/color.hpp>
 #include <cui/core/component.hpp>
 #include <cui/core/draw.hpp>
 #include <cui/core/floating.hpp>
+#include <cui/core/grid.hpp>
 #include <cui/core/node.hpp>
 #include <cui/core/pipeline.hpp>
 #include <cui/core/rect.hpp>
@@ -41,6 +52,7 @@
 #include <cui/util/assert.hpp>
 #include <cui/util/casting.hpp>
 #include <cui/util/common.h>
+#include <cui/util/fixed_string.hpp>
 #include <cui/util/functional.hpp>
 #include <cui/util/iterator.hpp>
 #include <cui/util/meta.hpp>
@@ -55,5 +67,9 @@
 #include <cui/widget/clock.hpp>
 #include <cui/widget/fill.hpp>
 #include <cui/widget/inplace.hpp>
+#include <cui/widget/list.hpp>
 #include <cui/widget/padding.hpp>
+#include <cui/widget/paragraph.hpp>
+#include <cui/widget/pipeline.hpp>
+#include <cui/widget/scroll.hpp>
 #include <cui/widget/text.hpp>
@@ -20,11 +20,15 @@
 
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <utility>
 #include <cui/core/color.hpp>
 #include <cui/core/paint.hpp>
 #include <cui/core/rect.hpp>
 #include <cui/core/vector.hpp>
 #include <cui/fwd.hpp>
+#include <cui/util/fixed_string.hpp>
 #include <fmt/format.h>
 
 template <>
@@ -67,3 +71,31 @@ struct fmt::formatter<cui::Paint> : fmt::formatter<fmt::string_view> {
                      obj.color());
   }
 };
+
+namespace cui {
+/// Formats the arguments directly into the inline buffer of the FixedString
+/// and applies the truncation if the result exceeds its capacity:
+///
+/// ```cpp
+/// StaticText<8> label(parent);
+///
+/// FixedString<8> str;
+/// format_into(str, Truncation::Ellipsis, "{}°C", temperature);
+/// label.setText(str);
+/// ```
+///
+/// \returns false if the result was truncated
+template <std::size_t N, typename S, typename... Args>
+bool format_into(FixedString<N>& out, Truncation truncation, S const& format,
+                 Args&&... args) {
+  out.clear();
+
+  auto const result = fmt::format_to_n(std::back_inserter(out), N, format,
+                                       std::forward<Args>(args)...);
+  if (result.size > N) {
+    out.truncate(truncation);
+    return false;
+  }
+  return true;
+}
+} // namespace cui
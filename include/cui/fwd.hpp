@@ -25,6 +25,8 @@ class Node;
 class Container;
 class Widget;
 class Canvas;
+template <typename>
+class BasicCanvas;
 class Paint;
 class Surface;
 class Context;
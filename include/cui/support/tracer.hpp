@@ -57,6 +57,7 @@ public:
                 Paint const& paint) noexcept override;
 
   Vec2 stringBounds(std::string_view str) noexcept override;
+  Point glyphAdvance(char glyph) noexcept override;
 
 private:
   Surface* proxy_;
@@ -0,0 +1,164 @@
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <cui/core/color.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/surface.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/util/common.h>
+#include <cui/util/span.hpp>
+
+namespace cui {
+/// Implements a Surface that records the draw commands of every window into
+/// a display list and only rasterizes the tiles whose content has changed.
+///
+/// The Surface is divided into square tiles, every recorded command is hashed
+/// into the tiles it covers. When the window is ended, the hash of every tile
+/// is compared to the one of the previous paint, and the display list is
+/// replayed on the underlying Surface for the bounds of the changed tiles only.
+/// Windows without any changed tile are not passed on at all.
+///
+/// The painted strings and images are copied into the payload buffer because
+/// they are commonly temporaries which are gone before the window is ended.
+/// A window whose display list or payload overflows is passed through
+/// uncached.
+///
+/// ```cpp
+/// CachedSurface::Command commands[64];
+/// std::uint8_t payload[512];
+/// std::uint32_t hashes[CachedSurface::capacity(resolution)];
+/// CachedSurface surface(raster_surface, commands, payload, hashes);
+/// ```
+class CUI_API CachedSurface final : public Surface {
+public:
+  /// Describes a recorded draw command
+  struct Command {
+    enum class Kind : std::uint8_t {
+      View,
+      Point,
+      Line,
+      Rect,
+      Circle,
+      Image,
+      BitImage,
+      Text
+    };
+
+    Kind kind{Kind::View};
+    bool filled{false};
+    Point radius{0};
+    Color color;
+    Vec2 position;
+    Rect area;
+    // The position of the copied string or image inside the payload
+    std::size_t offset{0};
+    // The count of characters or pixel values of the string or image
+    std::size_t size{0};
+  };
+
+  explicit CachedSurface(Surface& surface, Span<Command> commands,
+                         Span<std::uint8_t> payload, Span<std::uint32_t> hashes,
+                         Point tile = 16) noexcept;
+
+  /// Returns the count of tile hashes required for the given resolution
+  [[nodiscard]] static constexpr std::size_t
+  capacity(Vec2 resolution, Point tile = 16) noexcept {
+    return 2 * tiles(resolution.x, tile) * tiles(resolution.y, tile);
+  }
+
+  /// Forgets the content of all tiles, which forwards the next paint entirely
+  void invalidate() noexcept;
+
+  bool changed() noexcept override;
+  void begin(Rect const& window) noexcept override;
+  void end() noexcept override;
+  void flush() noexcept override;
+  Vec2 resolution() const noexcept override;
+  void view(Vec2 offset, Rect const& clip_space) noexcept override;
+  Rect split(Rect& area) const noexcept override;
+  bool scroll(Rect const& area, Vec2 offset) noexcept override;
+
+  void drawPoint(Vec2 position, Paint const& paint) noexcept override;
+  void drawLine(Vec2 from, Vec2 to, Paint const& paint) noexcept override;
+  void drawRect(Rect const& rect, Paint const& paint) noexcept override;
+  void drawCircle(Vec2 position, Point radius,
+                  Paint const& paint) noexcept override;
+  void drawImage(Rect const& area,
+                 Span<std::uint16_t const> image) noexcept override;
+  void drawBitImage(Rect const& area, Span<std::uint8_t const> image,
+                    Paint const& imbue) noexcept override;
+  void drawText(Vec2 position, std::string_view str,
+                Paint const& paint) noexcept override;
+
+  Vec2 stringBounds(std::string_view str) noexcept override;
+  Point glyphAdvance(char glyph) noexcept override;
+
+private:
+  [[nodiscard]] static constexpr std::size_t tiles(Point length,
+                                                   Point tile) noexcept {
+    return static_cast<std::size_t>((length + tile - 1) / tile);
+  }
+
+  /// Records the command which draws inside the given untranslated bounds,
+  /// and copies the string or image it references into the payload
+  void record(Command command, Rect const& bounds,
+              void const* data = nullptr) noexcept;
+
+  /// Issues the recorded command on the underlying Surface
+  void replay(Command const& command) noexcept;
+
+  /// Issues the command with the given string or image on the underlying
+  /// Surface
+  void replay(Command const& command, void const* data) noexcept;
+
+  /// Returns the tile indices covered by the given area
+  [[nodiscard]] Rect range(Rect const& area) const noexcept;
+
+  /// Returns the area of the tile at the given tile index
+  [[nodiscard]] Rect tile(Vec2 index) const noexcept;
+
+  [[nodiscard]] std::uint32_t& current(Vec2 index) noexcept;
+  [[nodiscard]] std::uint32_t& pending(Vec2 index) noexcept;
+
+  Surface* surface_;
+  Span<Command> commands_;
+  Span<std::uint8_t> payload_;
+  Span<std::uint32_t> hashes_;
+  Point tile_;
+
+  // The count of tiles in a row
+  std::size_t columns_{0};
+  // The count of recorded commands
+  std::size_t size_{0};
+  // The count of used payload bytes
+  std::size_t used_{0};
+  // The currently painted window
+  Rect window_;
+  // The currently set view
+  Vec2 offset_;
+  Rect clip_space_;
+  // Describes whether the current window is passed through uncached
+  bool passthrough_{false};
+};
+} // namespace cui
@@ -171,6 +171,19 @@ public:
     }
   }
 
+  Point glyphAdvance(char glyph) noexcept override {
+    // Glyph positions are only known if all Surfaces agree on them
+    Point advance = 0;
+    for (auto&& surface : container_) {
+      Point const current = surface.glyphAdvance(glyph);
+      if (!current || (advance && (advance != current))) {
+        return 0;
+      }
+      advance = current;
+    }
+    return advance;
+  }
+
 private:
   bool changed_{false};
   Container* container_;
@@ -46,6 +46,8 @@ public:
 
   Rect split(Rect& area) const noexcept override;
 
+  bool scroll(Rect const& area, Vec2 offset) noexcept override;
+
   void drawPoint(Vec2 position, Paint const& paint) noexcept override;
 
   void drawLine(Vec2 from, Vec2 to, Paint const& paint) noexcept override;
@@ -66,6 +68,8 @@ public:
 
   Vec2 stringBounds(std::string_view str) noexcept override;
 
+  Point glyphAdvance(char glyph) noexcept override;
+
 private:
   bool changed_{true};
 };
@@ -18,4 +18,6 @@
   along with this program. If not, see <https://www.gnu.org/licenses/>.
 **/
 
+#include <cui/surface/raster/diff.hpp>
+#include <cui/surface/raster/layer.hpp>
 #include <cui/surface/raster/raster.hpp>
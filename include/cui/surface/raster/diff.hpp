@@ -0,0 +1,242 @@
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/surface/raster/raster.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/span.hpp>
+
+namespace cui {
+/// A Sink that keeps a shadow copy of the display content and only forwards
+/// the parts of an updated window which actually differ from it.
+///
+/// Every window is compared row by row against the shadow copy. Changed rows
+/// are grouped into bands (rows that are at most `gap` rows apart are merged),
+/// and each band is shrunk to the columns that changed before it is passed
+/// to the underlying Sink. Windows without any change are not forwarded.
+///
+/// The shadow buffer must be able to hold the whole display in its native
+/// orientation, so at least `SurfaceType::capacity(resolution)` values.
+///
+/// ```cpp
+/// BitRasterSurface::value_type shadow[BitRasterSurface::capacity(res)];
+/// DiffSink<BitRasterSurface> diff(sink, shadow, res);
+/// BitRasterSurface surface(buffer, diff, res);
+/// ```
+template <typename SurfaceType>
+class DiffSink final : public SurfaceType::Sink {
+public:
+  using value_type = typename SurfaceType::value_type;
+  using Sink = typename SurfaceType::Sink;
+
+  explicit DiffSink(Sink& sink, Span<value_type> shadow, Vec2 resolution,
+                    Point gap = 8) noexcept
+    : sink_(&sink)
+    , shadow_(shadow)
+    , resolution_(resolution)
+    , gap_(gap) {
+    CUI_ASSERT(shadow_.size() >= SurfaceType::capacity(resolution_));
+  }
+
+  /// Marks the shadow copy as unknown, which forwards all windows of the next
+  /// update process unconditionally (for instance after clearing the display).
+  void invalidate() noexcept {
+    valid_ = false;
+  }
+
+  Span<value_type> update(Span<value_type> buffer,
+                          Rect const& window) noexcept override {
+    constexpr Point density = SurfaceType::density();
+
+    CUI_ASSERT(window.low.x % density == 0);
+    CUI_ASSERT(Rect::with(resolution_).contains(window));
+
+    std::size_t const stride = SurfaceType::capacity({window.width(), 1});
+    std::size_t const offset = static_cast<std::size_t>(window.low.x /
+                                                        density);
+
+    if (!valid_) {
+      for (Point y = 0; y < window.height(); ++y) {
+        value_type const* const row = buffer.data() + y * stride;
+        std::copy(row, row + stride, shadow(window.low.y + y) + offset);
+      }
+
+      return sink_->update(buffer, window);
+    }
+
+    // The buffer the next band is packed into, which is the span returned by
+    // the underlying sink for the previous band. The incoming buffer is only
+    // read for comparing after it was passed to the sink.
+    Span<value_type> result = buffer;
+
+    // The currently changed band of rows and its changed columns
+    Point first = -1;
+    Point last = -1;
+    std::size_t left = stride;
+    std::size_t right = 0;
+
+    for (Point y = 0; y < window.height(); ++y) {
+      value_type const* const row = buffer.data() + y * stride;
+      value_type* const current = shadow(window.low.y + y) + offset;
+
+      if (std::equal(row, row + stride, current)) {
+        continue;
+      }
+
+      if ((first >= 0) && (y - last - 1 > gap_)) {
+        result = forward(result, window, first, last, left, right);
+        left = stride;
+        right = 0;
+        first = -1;
+      }
+
+      std::size_t low = 0;
+      while (row[low] == current[low]) {
+        ++low;
+      }
+
+      std::size_t high = stride - 1;
+      while (row[high] == current[high]) {
+        --high;
+      }
+
+      std::copy(row + low, row + high + 1, current + low);
+
+      if (first < 0) {
+        first = y;
+      }
+      last = y;
+      left = min(left, low);
+      right = max(right, high);
+    }
+
+    if (first >= 0) {
+      result = forward(result, window, first, last, left, right);
+    }
+
+    return result;
+  }
+
+  void flush() noexcept override {
+    sink_->flush();
+    valid_ = true;
+  }
+
+  bool scroll(Rect const& area, Vec2 offset) noexcept override {
+    constexpr Point density = SurfaceType::density();
+
+    // Packed values of the shadow copy can only be shifted as a whole
+    if ((area.low.x % density != 0) || (area.width() % density != 0) ||
+        (offset.x % density != 0)) {
+      return false;
+    }
+
+    if (!sink_->scroll(area, offset)) {
+      return false;
+    }
+
+    Point const width = area.width() - abs(offset.x);
+    Point const height = area.height() - abs(offset.y);
+
+    if ((width > 0) && (height > 0)) {
+      std::size_t const count = SurfaceType::capacity({width, 1});
+      std::size_t const from = static_cast<std::size_t>(
+          (area.low.x + max(-offset.x, Point(0))) / density);
+      std::size_t const to = static_cast<std::size_t>(
+          (area.low.x + max(offset.x, Point(0))) / density);
+
+      // Rows are shifted in an order which never overwrites pending rows
+      bool const upwards = offset.y <= 0;
+      for (Point i = 0; i < height; ++i) {
+        Point const y = upwards ? (area.low.y + max(offset.y, Point(0)) + i)
+                                : (area.high.y - i);
+
+        value_type const* const source = shadow(y - offset.y) + from;
+        value_type* const target = shadow(y) + to;
+
+        if (target <= source) {
+          std::copy(source, source + count, target);
+        } else {
+          std::copy_backward(source, source + count, target + count);
+        }
+      }
+    }
+
+    // The exposed part of the area is unknown until it was painted again
+    valid_ = false;
+    return true;
+  }
+
+private:
+  value_type* shadow(Point y) noexcept {
+    return shadow_.data() + SurfaceType::capacity({resolution_.x, 1}) * y;
+  }
+
+  /// Copies the changed band out of the shadow into the front of the given
+  /// buffer and passes it to the underlying sink.
+  ///
+  /// The buffer is either the incoming one or the span the sink returned for
+  /// the previous band, so a buffer is never passed to the sink twice.
+  /// When packing into the incoming buffer, the band always lies in front of
+  /// the rows that were not compared yet, thus the packed copy never
+  /// overwrites pending content of the buffer.
+  Span<value_type> forward(Span<value_type> buffer, Rect const& window,
+                           Point first, Point last, std::size_t left,
+                           std::size_t right) noexcept {
+    constexpr Point density = SurfaceType::density();
+
+    Point const low = window.low.x + static_cast<Point>(left * density);
+    Point const high = min(static_cast<Point>(window.low.x +
+                                              (right + 1) * density - 1),
+                           window.high.x);
+
+    Rect const band{{low, static_cast<Point>(window.low.y + first)},
+                    {high, static_cast<Point>(window.low.y + last)}};
+
+    std::size_t const width = right - left + 1;
+    std::size_t const offset = static_cast<std::size_t>(low / density);
+
+    CUI_ASSERT(width == SurfaceType::capacity({band.width(), 1}));
+    CUI_ASSERT(SurfaceType::capacity(band.size()) <= buffer.size());
+
+    value_type* out = buffer.data();
+    for (Point y = band.low.y; y <= band.high.y; ++y) {
+      value_type const* const row = shadow(y) + offset;
+      out = std::copy(row, row + width, out);
+    }
+
+    return sink_->update(buffer, band);
+  }
+
+  Sink* sink_;
+  // The last known content of the display
+  Span<value_type> shadow_;
+  // The native display resolution
+  Vec2 resolution_;
+  // The count of unchanged rows that are merged into a changed band
+  Point gap_;
+  // Describes whether the shadow copy reflects the display content
+  bool valid_{false};
+};
+} // namespace cui
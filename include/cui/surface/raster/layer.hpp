@@ -0,0 +1,67 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <cui/component/layer.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/common.h>
+#include <cui/util/span.hpp>
+
+namespace cui {
+/// A LayerComponent that retains the content of its owning Container as
+/// 16 bit pixels encoded the same way as a WideRasterSurface encodes them.
+///
+/// The layer is composited through Surface::drawImage, which makes it exact
+/// on a WideRasterSurface. The given pixels are the memory budget of the
+/// layer, visible areas of the Container that exceed it are painted
+/// directly instead.
+///
+/// Layers are opaque, pixels that are not painted by the children of the
+/// Container are white, the same as the background of a RasterSurface.
+///
+/// ```cpp
+/// class Panel : public Container {
+///   std::uint16_t pixels_[WideRasterSurface::capacity({64, 32})];
+///   RasterLayer layer_{*this, pixels_};
+/// };
+/// ```
+///
+/// \attention The pixels are referenced and not moved together with the
+///            layer.
+class CUI_API RasterLayer final : public LayerComponent {
+public:
+  explicit RasterLayer(Node& owner, Span<std::uint16_t> pixels) noexcept;
+
+  RasterLayer(RasterLayer&&) noexcept = default;
+  RasterLayer& operator=(RasterLayer&&) noexcept = default;
+
+protected:
+  bool record(Surface& surface, Rect const& visible) noexcept override;
+
+  void draw(Surface& surface, Rect const& area,
+            Rect const& clip) noexcept override;
+
+private:
+  Span<std::uint16_t> pixels_;
+};
+} // namespace cui
@@ -59,20 +59,28 @@ public:
     clip_space_ = area;
   }
 
+  /// Returns the bounds of all pixels drawn since the last reset
+  [[nodiscard]] constexpr Rect const& touched() const noexcept {
+    return touched_;
+  }
+
   void drawPixel(std::int16_t x, std::int16_t y, std::uint16_t color) override {
     if (clip_space_.contains(Vec2{x, y})) {
+      touch(Rect{{x, y}, {x, y}});
       T::drawPixel(x, y, color);
     }
   }
   void drawFastVLine(std::int16_t x, std::int16_t y, std::int16_t h,
                      std::uint16_t color) override {
     if (Rect line = clip_space_.clip(Rect::with({x, y}, {1, h}))) {
+      touch(line);
       T::drawFastVLine(line.low.x, line.low.y, line.height(), color);
     }
   }
   void drawFastHLine(std::int16_t x, std::int16_t y, std::int16_t w,
                      std::uint16_t color) override {
     if (Rect line = clip_space_.clip(Rect::with({x, y}, {w, 1}))) {
+      touch(line);
       T::drawFastHLine(line.low.x, line.low.y, line.width(), color);
     }
   }
@@ -82,8 +90,14 @@ public:
   }
 
 private:
+  constexpr void touch(Rect const& area) noexcept {
+    touched_ = touched_ ? Rect::ofUnion(touched_, area) : area;
+  }
+
   // This class handles clipping
   Rect clip_space_{Rect::all()};
+  // The bounds of the drawn pixels
+  Rect touched_{Rect::none()};
 };
 } // namespace detail
 
@@ -169,6 +183,16 @@ public:
     /// Is called after all window updates were issued in the current update
     /// process
     virtual void flush() {}
+
+    /// Is called to shift the content of the display inside the given area
+    /// by the given offset, \see Surface::scroll
+    ///
+    /// \returns false if the display content can't be shifted
+    virtual bool scroll(Rect const& area, Vec2 offset) noexcept {
+      (void)area;
+      (void)offset;
+      return false;
+    }
   };
 
   explicit RasterSurface(Span<value_type> buffer, Sink& sink,
@@ -198,6 +222,12 @@ public:
     }
   }
 
+  /// Returns the count of horizontal pixels that are encoded into a single
+  /// buffer value in the native orientation of the display
+  [[nodiscard]] static constexpr Point density() noexcept {
+    return Characteristics::density();
+  }
+
   /// Returns the color representation of the given color
   [[nodiscard]] static constexpr value_type encode(Color color) noexcept {
     return static_cast<value_type>(Characteristics::encode(color));
@@ -207,6 +237,18 @@ public:
     changed_ = true;
   }
 
+  /// Enables passing only the bounding box of the pixels that were actually
+  /// drawn inside a window to the Sink, windows in which nothing was drawn
+  /// are not passed to the Sink at all.
+  ///
+  /// \attention Pixels outside of the drawn bounds are never transferred,
+  ///            which means that previous content of the display is not
+  ///            erased there. Only enable this if the display content below
+  ///            repainted windows is known to be blank.
+  void setTrimming(bool enabled) noexcept {
+    trimming_ = enabled;
+  }
+
   bool changed() noexcept override {
     if (changed_) {
       changed_ = false;
@@ -246,6 +288,8 @@ public:
 
   Vec2 stringBounds(std::string_view str) noexcept override;
 
+  Point glyphAdvance(char glyph) noexcept override;
+
   [[nodiscard]] Vec2 resolution() const noexcept override {
     if (isRotated(rotation_)) {
       return resolution_.transpose();
@@ -266,7 +310,13 @@ public:
     return ret;
   }
 
+  bool scroll(Rect const& area, Vec2 offset) noexcept override;
+
 private:
+  /// Packs the given sub area of the native window area to the front
+  /// of the buffer and returns the sub area aligned to whole buffer values
+  Rect pack(Rect const& area, Rect sub) noexcept;
+
   Sink* sink_;
 
   // The currently used buffer
@@ -280,6 +330,8 @@ private:
 
   // Describes whether this surface was changed
   bool changed_{false};
+  // Describes whether windows are trimmed to their drawn bounds
+  bool trimming_{false};
 
   // Describes the applied rotation
   Rotation rotation_{Rotation::Rotate_0};
@@ -295,6 +347,10 @@ struct CUI_API WxH {
     return static_cast<std::size_t>(size.x) * size.y;
   }
 
+  [[nodiscard]] static constexpr Point density() noexcept {
+    return 1;
+  }
+
   [[nodiscard]] static Rect split(Rotation rotation, Rect& area,
                                   Vec2 resolution,
                                   std::size_t capacity) noexcept;
@@ -311,6 +367,10 @@ struct CUI_API BitCompressed {
     return ((static_cast<std::size_t>(size.x) + 7) / 8) * size.y;
   }
 
+  [[nodiscard]] static constexpr Point density() noexcept {
+    return 8;
+  }
+
   [[nodiscard]] static Rect split(Rotation rotation, Rect& area,
                                   Vec2 resolution,
                                   std::size_t capacity) noexcept;
@@ -0,0 +1,195 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace cui {
+/// Describes how content that exceeds the capacity of a FixedString is cut
+enum class Truncation : std::uint8_t {
+  Clip,    ///< Drops the characters that don't fit
+  Ellipsis ///< Drops the characters that don't fit and ends with "..."
+};
+
+/// A string of up to N characters which are stored inline without
+/// any allocation, content exceeding the capacity is truncated.
+///
+/// ```cpp
+/// constexpr FixedString<8> label("12:00");
+/// ```
+///
+/// \see format_into for formatting into the inline buffer directly
+template <std::size_t N>
+class FixedString {
+  static_assert((N > 0) && (N <= 0xFFFF));
+
+public:
+  using value_type = char;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = char&;
+  using const_reference = char const&;
+  using pointer = char*;
+  using const_pointer = char const*;
+  using iterator = char*;
+  using const_iterator = char const*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  constexpr FixedString() noexcept = default;
+  /* implicit */ constexpr FixedString(std::string_view str) noexcept {
+    assign(str);
+  }
+  /* implicit */ constexpr FixedString(char const* str) noexcept
+    : FixedString(std::string_view(str)) {}
+  explicit constexpr FixedString(std::string_view str,
+                                 Truncation truncation) noexcept {
+    assign(str, truncation);
+  }
+
+  /// Returns the maximum count of characters
+  [[nodiscard]] static constexpr size_type capacity() noexcept {
+    return N;
+  }
+
+  /// Replaces the content with the given string
+  ///
+  /// \returns false if the string was truncated
+  constexpr bool assign(std::string_view str,
+                        Truncation truncation = Truncation::Clip) noexcept {
+    clear();
+    return append(str, truncation);
+  }
+
+  /// Appends the given string to the content
+  ///
+  /// \returns false if the string was truncated
+  constexpr bool append(std::string_view str,
+                        Truncation truncation = Truncation::Clip) noexcept {
+    for (char const c : str) {
+      if (size_ == N) {
+        truncate(truncation);
+        return false;
+      }
+      push_back(c);
+    }
+    return true;
+  }
+
+  /// Appends the character if the capacity allows it, otherwise
+  /// the character is dropped
+  constexpr void push_back(char c) noexcept {
+    if (size_ < N) {
+      data_[size_++] = c;
+      data_[size_] = '\0';
+    }
+  }
+
+  /// Applies the truncation to the end of the content, which is required
+  /// when content was dropped because of the capacity.
+  constexpr void truncate(Truncation truncation) noexcept {
+    if (truncation == Truncation::Ellipsis) {
+      for (size_type i = (size_ < 3) ? 0 : (size_ - 3); i < size_; ++i) {
+        data_[i] = '.';
+      }
+    }
+  }
+
+  constexpr void clear() noexcept {
+    size_ = 0;
+    data_[0] = '\0';
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return size_ == 0U;
+  }
+  [[nodiscard]] constexpr size_type size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] constexpr char* data() noexcept {
+    return data_;
+  }
+  [[nodiscard]] constexpr char const* data() const noexcept {
+    return data_;
+  }
+  /// Returns the null terminated content
+  [[nodiscard]] constexpr char const* c_str() const noexcept {
+    return data_;
+  }
+
+  [[nodiscard]] constexpr char& operator[](size_type idx) noexcept {
+    return data_[idx];
+  }
+  [[nodiscard]] constexpr char const&
+  operator[](size_type idx) const noexcept {
+    return data_[idx];
+  }
+
+  [[nodiscard]] constexpr iterator begin() noexcept {
+    return data_;
+  }
+  [[nodiscard]] constexpr iterator end() noexcept {
+    return data_ + size_;
+  }
+  [[nodiscard]] constexpr const_iterator begin() const noexcept {
+    return data_;
+  }
+  [[nodiscard]] constexpr const_iterator end() const noexcept {
+    return data_ + size_;
+  }
+  [[nodiscard]] constexpr reverse_iterator rbegin() noexcept {
+    return reverse_iterator(end());
+  }
+  [[nodiscard]] constexpr reverse_iterator rend() noexcept {
+    return reverse_iterator(begin());
+  }
+  [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept {
+    return {data_, size_};
+  }
+  /* implicit */ constexpr operator std::string_view() const noexcept {
+    return view();
+  }
+
+  [[nodiscard]] friend constexpr bool
+  operator==(FixedString const& left, std::string_view right) noexcept {
+    return left.view() == right;
+  }
+  [[nodiscard]] friend constexpr bool
+  operator!=(FixedString const& left, std::string_view right) noexcept {
+    return left.view() != right;
+  }
+
+private:
+  char data_[N + 1]{};
+  std::uint16_t size_{0};
+};
+} // namespace cui
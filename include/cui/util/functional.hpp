@@ -91,7 +91,8 @@ protected:
                   "Can't bind a mutable member function to a const one!");
     static_assert(std::is_base_of<OtherClass, Class>::value,
                   "Can only cast to a derived class!");
-    return (self.*Value)(std::forward<OtherArgs>(args)...);
+    return (static_cast<Class const&>(self).*Value)(
+        std::forward<OtherArgs>(args)...);
   }
 
 public:
@@ -116,7 +117,8 @@ protected:
                   "Can't bind a mutable member function to a const one!");
     static_assert(std::is_base_of<OtherClass, Class>::value,
                   "Can only cast to a derived class!");
-    return (self.*Value)(std::forward<OtherArgs>(args)...);
+    return (static_cast<Class const&>(self).*Value)(
+        std::forward<OtherArgs>(args)...);
   }
 
 public:
@@ -25,6 +25,30 @@
 namespace cui {
 using TypeID = std::uint16_t;
 
+/// TypeIDs below this limit are assigned densely through a specialization
+/// of type_trait, hashed TypeIDs are never part of this range.
+///
+/// The presence of Components with a dense TypeID is tracked exactly per
+/// Node, thus commonly used Component types should be assigned one:
+///   -  0: Widget
+///   -  1: Container
+///   -  2: ComponentIndexBase
+///   -  3: MountComponent
+///   -  4: RefComponent
+///   -  5: DropComponent
+///   -  6: InputComponent
+///   -  7: AnimationComponent
+///   -  8: RegistryComponent
+///   -  9: TraversalCache
+///   - 10: PaintWorklistBase
+///   - 11: LayerComponent
+///   - 12: ScrollComponent
+///   - 13: SpatialIndex
+///   - 14: SiblingOrderBase
+///   - 15: Reserved for further builtin types
+///   - 16-31: Free for user defined types
+inline constexpr TypeID dense_type_limit = 32;
+
 template <typename T>
 struct type_trait;
 } // namespace cui
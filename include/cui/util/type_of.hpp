@@ -30,7 +30,8 @@ namespace cui {
 /// Returns the numeric TypeID of the given type T
 ///
 /// \note The TypeID is calculated at compile-time from the name of the
-///       type and its size, including the namespace of the type.
+///       type and its size, including the namespace of the type, unless a
+///       dense TypeID was assigned to the type through type_trait.
 ///       The resulting TypeID is guaranteed to be equal on all platforms as
 ///       long as the size of the type doesn't differ on both platforms.
 template <typename T>
@@ -49,7 +50,12 @@ template <typename T>
                                                         sizeof(size)),
                                           name.data(), name.size());
 
-    return type;
+    // Move the hashed TypeID out of the range of dense TypeIDs
+    if constexpr (type < dense_type_limit) {
+      return static_cast<TypeID>(type + dense_type_limit);
+    } else {
+      return type;
+    }
   }
 }
 } // namespace cui
@@ -35,6 +35,8 @@ struct Alignment {
 };
 
 class CUI_API AlignContainer final : public Container {
+  friend NodeAccess;
+
 public:
   explicit AlignContainer(Container& parent) noexcept
     : Container(parent) {}
@@ -36,6 +36,8 @@ struct BitMapImage {
 ///
 /// \note Editor: https://emutyworks.github.io/BitmapEditor/demo/index.html
 class CUI_API BitMap final : public Widget {
+  friend NodeAccess;
+
 public:
   explicit BitMap(BitMapImage const& image,
                   Paint imbue = Paint::empty()) noexcept
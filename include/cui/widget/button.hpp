@@ -29,6 +29,8 @@
 
 namespace cui {
 class CUI_API Button final : public Widget {
+  friend NodeAccess;
+
 public:
   using Widget::Widget;
   using Widget::operator=;
@@ -27,6 +27,8 @@
 
 namespace cui {
 class CUI_API CenterContainer final : public Container {
+  friend NodeAccess;
+
 public:
   explicit CenterContainer(Container& parent) noexcept
     : Container(parent) {}
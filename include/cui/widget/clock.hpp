@@ -23,12 +23,15 @@
 #include <chrono>
 #include <cui/component/animation.hpp>
 #include <cui/core/node.hpp>
+#include <cui/core/rect.hpp>
 #include <cui/fwd.hpp>
 #include <cui/util/common.h>
 #include <cui/util/functional.hpp>
 
 namespace cui {
 class CUI_API Clock final : public Widget {
+  friend NodeAccess;
+
 public:
   enum Granularity : std::uint8_t {
     Seconds = 0x1, ///< Display seconds
@@ -49,9 +52,14 @@ public:
     return granularity_;
   }
 
+  /// Returns the time between two steps of the finest displayed needle
+  [[nodiscard]] Duration resolution() const noexcept;
+
   /// Set the Granularity
   void setGranularity(std::uint8_t granularity) noexcept;
 
+  /// Set the displayed time, which only repaints the area of the needles
+  /// if they moved
   void setTime(Duration duration_since_midnight) noexcept;
 
 protected:
@@ -60,6 +68,12 @@ protected:
   void paint(Canvas& canvas) const noexcept override;
 
 private:
+  [[nodiscard]] Vec2 origin() const noexcept;
+  [[nodiscard]] Point radius() const noexcept;
+
+  /// Returns the bounds of all needles displayed at the given time
+  [[nodiscard]] Rect needles(Duration time) const noexcept;
+
   Duration time_point_{std::chrono::seconds(2) + std::chrono::minutes(4) +
                        std::chrono::hours(8)};
 
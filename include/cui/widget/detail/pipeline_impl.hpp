@@ -0,0 +1,357 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <cui/core/access.hpp>
+#include <cui/core/algorithm.hpp>
+#include <cui/core/canvas.hpp>
+#include <cui/core/detail/pipeline_impl.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/widget/inplace.hpp>
+
+namespace cui::detail {
+/// Is true for Inplace trees whose children are statically known
+template <typename T>
+struct is_static_tree : std::false_type {};
+template <typename Parent, typename... T>
+struct is_static_tree<Inplace<Parent, T...>>
+  : std::bool_constant<(sizeof...(T) > 0)> {};
+
+/// Returns the concrete Node of an element of an Inplace tree
+template <typename T>
+constexpr auto& node_of(T& element) noexcept {
+  if constexpr (std::is_base_of_v<Node, T>) {
+    return element;
+  } else {
+    return *element;
+  }
+}
+
+template <typename T>
+using node_of_t = std::remove_reference_t<decltype(
+    node_of(std::declval<T&>()))>;
+
+/// Returns true if the children of the Inplace tree were not changed
+/// at runtime, which is required for walking them statically.
+template <typename Parent, typename... T>
+bool is_static(Inplace<Parent, T...>& tree) noexcept {
+  auto current = tree->begin();
+  auto const end = tree->end();
+
+  auto const next = [&](Node& child) {
+    if ((current == end) || (&*current != &child)) {
+      return false;
+    }
+
+    ++current;
+    return true;
+  };
+
+  bool const wired = std::apply(
+      [&](auto&... children) {
+        return (next(node_of(children)) && ...);
+      },
+      tree.elements());
+
+  return wired && (current == end);
+}
+
+template <bool Root, typename T>
+bool static_layout_node(Context& context, T& element) noexcept;
+
+template <bool Root, typename Parent, typename... T>
+bool static_layout_tree(Context& context,
+                        Inplace<Parent, T...>& tree) noexcept {
+  Parent& node = *tree;
+
+  if (!node.isLayoutDirty() && !node.isChildLayoutDirty()) {
+    return false;
+  }
+
+  auto const constrain = [&](auto& element, bool dirty) {
+    auto& child = node_of(element);
+
+    if (dirty) {
+      child.setConstraints(NodeAccess::onChildConstrain(node, child));
+    }
+
+    if (child.isLayoutCulled()) {
+      return true;
+    }
+
+    CUI_ASSERT(child.constraints().x >= 0);
+    CUI_ASSERT(child.constraints().y >= 0);
+
+    if (static_layout_node<false>(context, element) && !dirty) {
+      // Force a re-evaluation of the parent
+      NodeAccess::reflow(node);
+      return false;
+    }
+    return true;
+  };
+
+  bool completed;
+  do {
+    bool const dirty = node.isLayoutDirty();
+    if (dirty) {
+      NodeAccess::onLayoutBegin(node, context);
+    }
+
+    completed = std::apply(
+        [&](auto&... children) {
+          return (constrain(children, dirty) && ...);
+        },
+        tree.elements());
+  } while (!completed);
+
+  bool const dirty = node.isLayoutDirty();
+  NodeAccess::clearLayoutDirty(node);
+
+  if (!dirty) {
+    return false;
+  }
+
+  Vec2 const size = NodeAccess::onLayoutEnd(node, context);
+  CUI_ASSERT(size.x >= 0);
+  CUI_ASSERT(size.y >= 0);
+
+  if (Root || node.isRelayoutBoundary()) {
+    (void)size;
+    node.setSize(node.constraints());
+    return false;
+  } else {
+    return node.setSize(size);
+  }
+}
+
+template <bool Root, typename T>
+bool static_layout_node(Context& context, T& element) noexcept {
+  auto& node = node_of(element);
+
+  if constexpr (is_static_tree<T>::value) {
+    if (is_static(element)) {
+      return static_layout_tree<Root>(context, element);
+    }
+  } else if constexpr (std::is_base_of_v<Widget, node_of_t<T>>) {
+    static_assert(!Root);
+
+    if (!node.isLayoutDirty()) {
+      return false;
+    }
+
+    NodeAccess::clearLayoutDirty(node);
+
+    if (node.isRelayoutBoundary()) {
+      node.setSize(node.constraints());
+      return false;
+    }
+
+    Vec2 const size = NodeAccess::preferredSize(node, context);
+    CUI_ASSERT(size.x >= 0);
+    CUI_ASSERT(size.y >= 0);
+
+    return node.setSize(size);
+  }
+
+  return layout_nodes(context, node, Root);
+}
+
+template <bool ClearFlags, typename Surface, typename T>
+void static_paint_node(T& element, Surface& surface, Rect const& window,
+                       PositionRebuilder& stack,
+                       OcclusionStack& occluders) noexcept {
+  auto& node = node_of(element);
+  occluders.visit(node);
+
+  if constexpr (is_static_tree<T>::value) {
+    if (!is_static(element)) {
+      paint_nodes<ClearFlags>(node, surface, window, stack);
+      return;
+    }
+  } else if constexpr (!std::is_base_of_v<Widget, node_of_t<T>>) {
+    paint_nodes<ClearFlags>(node, surface, window, stack);
+    return;
+  }
+
+  stack.push(node);
+
+  if (Rect const clip = Rect::ofIntersect(window, stack.clip())) {
+    if (occluders.occluded(clip)) {
+      skip_occluded<ClearFlags>(node);
+
+      stack.pop(node);
+      return;
+    }
+
+    if constexpr (is_static_tree<T>::value) {
+      if (!paint_layer<ClearFlags>(node, surface, stack.translation(),
+                                   stack.clip(), clip)) {
+        occluders.enter(node, stack.translation(), clip);
+
+        std::apply(
+            [&](auto&... children) {
+              (static_paint_node<ClearFlags>(children, surface, window,
+                                             stack, occluders),
+               ...);
+            },
+            element.elements());
+
+        occluders.leave(node);
+      }
+    } else if constexpr (std::is_base_of_v<Widget, node_of_t<T>>) {
+      paint_widget(node, surface, stack.translation(), clip);
+    }
+  } else {
+    // If the current area is not drawn skip every child
+    stack.pop(node);
+    return;
+  }
+
+  if constexpr (ClearFlags) {
+    NodeAccess::clearPaintDirty(node);
+  }
+
+  stack.pop(node);
+}
+
+template <typename Surface, typename Root, typename T>
+void static_paint_into(Surface& surface, Root& root, T& element,
+                       Rect const& clip, Rect const& window,
+                       PositionRebuilder const& stack) noexcept {
+  CUI_ASSERT(window);
+
+  surface.begin(window);
+
+  if (clip.contains(window)) {
+    // See paint_into for the reason why this is possible
+    PositionRebuilder baseline = stack;
+    baseline.pop(node_of(element));
+
+    OcclusionStack occluders;
+    occluders.enterParents(node_of(element), baseline.translation(), window);
+    static_paint_node<true>(element, surface, window, baseline, occluders);
+  } else {
+    PositionRebuilder baseline;
+    OcclusionStack occluders;
+    static_paint_node<true>(root, surface, window, baseline, occluders);
+  }
+
+  surface.end();
+}
+
+template <typename Surface, typename Root, typename T>
+void static_paint_partial_node(Surface& surface, Root& root, T& element,
+                               PositionRebuilder& stack,
+                               OcclusionStack& occluders,
+                               bool& updated) noexcept {
+  auto& node = node_of(element);
+  occluders.visit(node);
+
+  if constexpr (is_static_tree<T>::value) {
+    if (!is_static(element)) {
+      paint_partial_nodes(*root, node, surface, stack, updated);
+      return;
+    }
+  } else if constexpr (!std::is_base_of_v<Widget, node_of_t<T>>) {
+    paint_partial_nodes(*root, node, surface, stack, updated);
+    return;
+  }
+
+  stack.push(node);
+
+  Rect const clip = stack.clip();
+  if (!clip) {
+    // If the current area is not drawn skip every child
+    stack.pop(node);
+    return;
+  }
+
+  if (node.isPaintDirty()) {
+    Rect remaining = affected_area(node, clip, stack.translation(), surface);
+
+    if (occluders.occluded(remaining)) {
+      skip_occluded<true>(node);
+    } else {
+      while (remaining) {
+        Rect const split = surface.split(remaining);
+        CUI_ASSERT(split); // No progress has been made!
+
+        static_paint_into(surface, root, element, clip, split, stack);
+      }
+
+      updated = true;
+      NodeAccess::clearPaintDirty(node);
+    }
+
+    stack.pop(node);
+    return;
+  }
+
+  if constexpr (is_static_tree<T>::value) {
+    if (!node.isChildPaintDirty()) {
+      stack.pop(node);
+      return;
+    }
+
+    if (node.isChildPaintDirtyDiverged()) {
+      Rect remaining = affected_area(node, clip, stack.translation(), surface);
+      Rect const split = surface.split(remaining);
+
+      if (!remaining) {
+        if (occluders.occluded(split)) {
+          skip_occluded<true>(node);
+        } else {
+          // We can draw the whole container inside the window
+          static_paint_into(surface, root, element, clip, split, stack);
+
+          updated = true;
+          NodeAccess::clearPaintDirty(node);
+        }
+
+        stack.pop(node);
+        return;
+      }
+
+      // Otherwise descend further
+    }
+
+    occluders.enter(node, stack.translation(), clip);
+
+    std::apply(
+        [&](auto&... children) {
+          (static_paint_partial_node(surface, root, children, stack,
+                                     occluders, updated),
+           ...);
+        },
+        element.elements());
+
+    occluders.leave(node);
+    NodeAccess::clearPaintDirty(node);
+  }
+
+  stack.pop(node);
+}
+} // namespace cui::detail
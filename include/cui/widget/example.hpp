@@ -122,6 +122,8 @@ static constexpr std::uint8_t rainy_data[] = {
 inline constexpr BitMapImage rainy{rainy_data, {32, 32}};
 
 class CUI_API Weather final : public Container {
+  friend NodeAccess;
+
 public:
   using Container::Container;
   using Container::operator=;
@@ -27,10 +27,17 @@
 
 namespace cui {
 class CUI_API FillContainer final : public Container {
+  friend NodeAccess;
+
 public:
+  FillContainer() noexcept {
+    setRelayoutBoundary();
+  }
   explicit FillContainer(Container& parent) noexcept
-    : Container(parent) {}
-  using Container::Container;
+    : Container(parent) {
+    setRelayoutBoundary();
+  }
+  FillContainer(FillContainer&&) noexcept = default;
   using Container::operator=;
 
 protected:
@@ -70,6 +70,14 @@ public:
     return parent_;
   }
 
+  /// Returns the statically typed children
+  std::tuple<T...>& elements() noexcept {
+    return children_;
+  }
+  std::tuple<T...> const& elements() const noexcept {
+    return children_;
+  }
+
 private:
   template <std::size_t... I>
   void wire(std::index_sequence<I...>) noexcept {
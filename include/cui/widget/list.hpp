@@ -0,0 +1,186 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <cui/component/scroll.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/fwd.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/common.h>
+#include <cui/util/functional.hpp>
+
+namespace cui {
+/// The type erased base of a ListView
+///
+/// Entries of the data source are shown in rows of a fixed height. Only the
+/// entries inside a window that starts at the first visible entry are bound
+/// to the recycled items, an entry keeps its item while it stays inside
+/// of the window.
+///
+/// Scrolling shifts the displayed rows through a ScrollComponent, only the
+/// items of entries that come into view are moved and painted again.
+///
+/// \attention The list must not be covered by siblings, \see ScrollComponent.
+class CUI_API ListViewBase : public Container {
+  friend NodeAccess;
+
+public:
+  /// Returns the count of entries of the data source
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns the height of every row
+  [[nodiscard]] constexpr Point row() const noexcept {
+    return row_;
+  }
+
+  /// Returns the offset of the viewport in pixels
+  [[nodiscard]] constexpr std::size_t offset() const noexcept {
+    return offset_;
+  }
+
+  /// Returns the index of the first visible entry
+  [[nodiscard]] constexpr std::size_t first() const noexcept {
+    return first_;
+  }
+
+  /// Sets the count of entries of the data source and binds every item again
+  void setSize(std::size_t size) noexcept;
+
+  /// Moves the viewport to the given offset, which is limited such that the
+  /// viewport stays inside of the rows
+  void scrollTo(std::size_t offset) noexcept;
+
+  /// Moves the viewport by the given distance
+  void scrollBy(std::ptrdiff_t distance) noexcept;
+
+  /// Binds every item again, for instance after the data source changed
+  void rebind() noexcept;
+
+protected:
+  explicit ListViewBase(Container& parent, Point row,
+                        std::size_t size) noexcept;
+
+  Constraints onLayoutConstrain(Node& child) noexcept override;
+  Vec2 onLayoutEnd(Context& context) noexcept override;
+
+  /// Returns the count of recycled items
+  [[nodiscard]] virtual std::size_t capacity() const noexcept = 0;
+
+  /// Returns the item which is recycled for the entry at the given index
+  [[nodiscard]] virtual Node& item(std::size_t index) noexcept = 0;
+
+  /// Binds the entry at the given index to its item
+  virtual void bind(std::size_t index) noexcept = 0;
+
+private:
+  /// Returns the end of the entries that are bound to an item
+  [[nodiscard]] std::size_t bound() const noexcept;
+
+  /// Moves every item to the row of its entry
+  void place() noexcept;
+
+  /// Returns the position of the item of the entry at the given index
+  [[nodiscard]] Vec2 position(std::size_t index) const noexcept;
+
+  Point row_;
+  std::size_t size_;
+  std::size_t offset_{0};
+  std::size_t first_{0};
+  ScrollComponent scroll_{*this};
+};
+
+/// A Container that shows a large amount of entries from a data source
+/// through a fixed pool of Capacity recycled items.
+///
+/// The binder is called whenever an item is recycled for another entry,
+/// thus memory and layout costs only depend on the Capacity instead of the
+/// count of entries. The Capacity should cover the rows of the viewport
+/// plus one partially visible row, rows beyond it are left empty.
+///
+/// ```cpp
+/// class Screen : public Container {
+///   void bindEntry(Text& item, std::size_t index) {
+///     item.setText(entries_[index]);
+///   }
+///
+///   ListView<Text, 9> log_{*this, 12, 10000, bind<&Screen::bindEntry>()};
+/// };
+/// ```
+///
+/// \attention Items are default constructed and must not be attached
+///            to another Container.
+template <typename Item, std::size_t Capacity>
+class ListView final : public ListViewBase {
+  static_assert(Capacity > 0, "A ListView requires at least one item!");
+
+public:
+  /// Binds the entry at the given index to the item
+  using Binder = void (*)(Node& receiver, Item& item, std::size_t index);
+
+  /// Creates a ListView whose binder is called on the given parent
+  template <typename T>
+  explicit ListView(Container& parent, Point row, std::size_t size,
+                    T&& binder) noexcept
+    : ListView(parent, row, size, std::forward<T>(binder), parent) {}
+
+  template <typename T, typename Receiver>
+  explicit ListView(Container& parent, Point row, std::size_t size,
+                    T&& binder, Receiver& receiver) noexcept
+    : ListViewBase(parent, row, size)
+    , binder_(static_cast<Binder>(std::forward<T>(binder)))
+    , receiver_(&receiver) {
+
+    for (Item& current : items_) {
+      push_back(current);
+    }
+
+    rebind();
+  }
+
+  ListView(ListView&&) = delete;
+  ListView& operator=(ListView&&) = delete;
+
+protected:
+  std::size_t capacity() const noexcept override {
+    return Capacity;
+  }
+
+  Node& item(std::size_t index) noexcept override {
+    return items_[index % Capacity];
+  }
+
+  void bind(std::size_t index) noexcept override {
+    CUI_ASSERT(index < size());
+
+    binder_(*receiver_, items_[index % Capacity], index);
+  }
+
+private:
+  Binder binder_;
+  Node* receiver_;
+  Item items_[Capacity];
+};
+} // namespace cui
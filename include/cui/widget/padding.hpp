@@ -58,6 +58,8 @@ struct Insets {
 };
 
 class CUI_API PaddingContainer final : public Container {
+  friend NodeAccess;
+
 public:
   explicit PaddingContainer(Container& parent) noexcept
     : Container(parent) {}
@@ -0,0 +1,127 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <cui/core/component.hpp>
+#include <cui/core/def.hpp>
+#include <cui/core/node.hpp>
+#include <cui/util/common.h>
+#include <cui/util/iterator.hpp>
+
+namespace cui {
+/// A base class for text displaying widgets that wrap their text at word
+/// boundaries into multiple lines, \see BasicParagraph
+///
+/// The line breaks are measured once for every text, constraint width and
+/// font and are reused by every following layout and paint. Every line is painted
+/// on its own, which skips the lines outside of the painted window.
+///
+/// Explicit line breaks are kept, words that are wider than the constraints
+/// are placed on a line of their own. Lines that don't fit into the capacity
+/// of the Paragraph are not displayed.
+template <typename T>
+class ParagraphBase : public Widget {
+  friend NodeAccess;
+
+public:
+  /// Describes a wrapped line of the text
+  struct Line {
+    std::uint16_t offset{0};
+    std::uint16_t size{0};
+    Point width{0};
+  };
+
+  using Widget::operator=;
+
+  void setText(T text);
+
+  [[nodiscard]] T const& text() const noexcept {
+    return text_;
+  }
+
+  /// Returns the lines which were wrapped on the last measurement
+  [[nodiscard]] Range<Line const*> lines() const noexcept;
+
+  Vec2 preferredSize(Context& context) const noexcept override;
+
+protected:
+  explicit ParagraphBase(Line* lines, std::size_t capacity, T text);
+  explicit ParagraphBase(Container& parent, Line* lines, std::size_t capacity,
+                         T text);
+
+  void paint(Canvas& canvas) const noexcept override;
+
+private:
+  /// Wraps the text into lines that fit into the given width
+  void wrap(Context& context, Point width) const noexcept;
+
+  [[nodiscard]] Line* data() const noexcept;
+
+  T text_;
+  Component::Offset lines_offset_;
+  std::uint8_t capacity_;
+  // The wrapped lines which are cached for the width until the text changes
+  mutable std::uint8_t size_{0};
+  mutable Point width_{-1};
+  mutable Point line_height_{0};
+  // The advance of a space in the font the lines were wrapped with
+  mutable Point space_{0};
+};
+
+/// A text displaying widget that wraps its text into up to MaxLines lines:
+///
+/// ```cpp
+/// Paragraph<4> notification(parent, "Battery low, connect the charger");
+/// ```
+template <typename T, std::size_t MaxLines>
+class BasicParagraph final : public ParagraphBase<T> {
+  static_assert((MaxLines > 0) && (MaxLines <= 0xFF));
+
+  using Line = typename ParagraphBase<T>::Line;
+
+public:
+  explicit BasicParagraph(T text = {})
+    : ParagraphBase<T>(lines_, MaxLines, std::move(text)) {}
+  explicit BasicParagraph(Container& parent, T text = {})
+    : ParagraphBase<T>(parent, lines_, MaxLines, std::move(text)) {}
+
+  using ParagraphBase<T>::operator=;
+
+private:
+  Line lines_[MaxLines];
+};
+
+/// An owning wrapped text displaying widget
+template <std::size_t MaxLines = 8>
+using Paragraph = BasicParagraph<std::string, MaxLines>;
+
+/// A non owning wrapped text displaying widget
+template <std::size_t MaxLines = 8>
+using ParagraphView = BasicParagraph<std::string_view, MaxLines>;
+
+extern template class CUI_API ParagraphBase<std::string>;
+extern template class CUI_API ParagraphBase<std::string_view>;
+} // namespace cui
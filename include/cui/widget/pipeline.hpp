@@ -0,0 +1,119 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cui/component/worklist.hpp>
+#include <cui/core/algorithm.hpp>
+#include <cui/core/canvas.hpp>
+#include <cui/core/pipeline.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/surface.hpp>
+#include <cui/widget/detail/pipeline_impl.hpp>
+#include <cui/widget/inplace.hpp>
+
+namespace cui {
+/// Layouts the given Inplace tree and its children
+///
+/// Behaves exactly like layout, but walks the statically known children of
+/// the tree at compile time, which makes it possible to call the layout methods
+/// of final node types directly instead of through a virtual dispatch.
+/// Children that are not part of an Inplace tree or trees whose children were
+/// changed at runtime are layouted through the dynamic algorithm.
+template <typename Parent, typename... T>
+void static_layout(Inplace<Parent, T...>& tree, Surface& surface) noexcept {
+  if constexpr (sizeof...(T) == 0) {
+    layout(*tree, surface);
+  } else {
+    Parent& node = *tree;
+
+    if (surface.changed()) {
+      reset(node);
+      node.setConstraints(surface.resolution());
+    } else if (!node.isAttached()) { // Top-level node
+      node.setConstraints(surface.resolution());
+    }
+
+    if (!node.isLayoutDirty() && !node.isChildLayoutDirty()) {
+      return;
+    }
+
+    Context context(surface);
+    detail::static_layout_node<true>(context, tree);
+  }
+}
+
+/// Paints the given Inplace tree like paint_full, but walks the statically
+/// known children of the tree at compile time.
+template <typename Surface, typename Parent, typename... T>
+void static_paint_full(Inplace<Parent, T...>& tree, Surface& surface,
+                       Rect clip = Rect::all()) noexcept {
+  PositionRebuilder stack;
+  detail::OcclusionStack occluders;
+  occluders.enterParents(*tree, stack.translation(), clip);
+
+  surface.begin(clip);
+  detail::static_paint_node<false>(tree, surface, clip, stack, occluders);
+  surface.end();
+}
+
+/// Paints the given Inplace tree like paint_partial, but walks the statically
+/// known children of the tree at compile time.
+///
+/// Roots with a complete worklist only visit the listed Nodes like
+/// paint_partial does.
+template <typename Surface, typename Parent, typename... T>
+void static_paint_partial(Inplace<Parent, T...>& tree,
+                          Surface& surface) noexcept {
+  bool updated = false;
+
+  Parent& node = *tree;
+
+  // Scrolled content is shifted first, so later paints are never moved
+  detail::scroll_nodes(node, surface, updated);
+
+  PaintWorklistBase* const worklist = node.isRoot()
+                                          ? any<PaintWorklistBase>(node)
+                                          : nullptr;
+
+  // Areas vacated by moved Nodes are painted before the Nodes themselves
+  if (worklist) {
+    detail::paint_damage(node, *worklist, surface, updated);
+  }
+
+  if (worklist && worklist->complete() && !node.isPaintDirty()) {
+    detail::paint_worklist_nodes(node, *worklist, surface, updated);
+  } else {
+    PositionRebuilder stack;
+    detail::OcclusionStack occluders;
+    occluders.enterParents(node, stack.translation(), Rect::all());
+    detail::static_paint_partial_node(surface, tree, tree, stack, occluders,
+                                      updated);
+  }
+
+  if (worklist) {
+    worklist->clear();
+  }
+
+  if (updated) {
+    surface.flush();
+  }
+}
+} // namespace cui
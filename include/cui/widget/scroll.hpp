@@ -0,0 +1,101 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cui/component/scroll.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/util/common.h>
+#include <cui/util/meta.hpp>
+#include <cui/widget/inplace.hpp>
+
+namespace cui {
+/// A Container that stacks its children vertically and shows them through
+/// a viewport of the size of its constraints.
+///
+/// Changing the offset moves the children without a relayout, the displayed
+/// content is shifted on the next partial paint and only the exposed strip
+/// is painted, \see ScrollComponent. Children outside of the viewport are
+/// culled by its clip space while painting.
+///
+/// Every child is constrained to the size of the viewport. Children outside
+/// of the viewport are culled from the layout as well, \see Container::cull,
+/// they keep the size of their last layout until they are scrolled into the
+/// viewport again. Children that were never laid out are always measured,
+/// since their size is required for the extent.
+class CUI_API ScrollContainer final : public Container {
+  friend NodeAccess;
+
+public:
+  ScrollContainer() noexcept {
+    setRelayoutBoundary();
+  }
+  explicit ScrollContainer(Container& parent) noexcept
+    : Container(parent) {
+    setRelayoutBoundary();
+  }
+  ScrollContainer(ScrollContainer&&) noexcept = default;
+  using Container::operator=;
+
+  /// Returns the offset of the viewport inside the stacked children
+  [[nodiscard]] constexpr Vec2 offset() const noexcept {
+    return offset_;
+  }
+
+  /// Returns the size of the stacked children
+  [[nodiscard]] constexpr Vec2 extent() const noexcept {
+    return extent_;
+  }
+
+  /// Moves the viewport to the given offset, which is limited such that
+  /// the viewport stays inside the extent of the children
+  void scrollTo(Vec2 offset) noexcept;
+
+  /// Moves the viewport by the given distance
+  void scrollBy(Vec2 distance) noexcept {
+    scrollTo(offset_ + distance);
+  }
+
+protected:
+  void onLayoutBegin(Context& context) noexcept override;
+  Constraints onLayoutConstrain(Node& child) noexcept override;
+  Vec2 onLayoutEnd(Context& context) noexcept override;
+
+private:
+  [[nodiscard]] Vec2 limit(Vec2 offset) const noexcept;
+
+  /// Culls the children outside of the viewport and returns true if a culled
+  /// child inside of it is still layout dirty or was constrained differently
+  bool cullHidden() noexcept;
+
+  Vec2 offset_;
+  Vec2 extent_;
+  Point top_{0};
+  Node const* previous_{nullptr};
+  ScrollComponent scroll_{*this};
+};
+
+template <typename... T>
+[[nodiscard]] constexpr auto Scroll(T&&... children) noexcept {
+  return Inplace(type_identity<ScrollContainer>{}, inplace,
+                 std::forward<T>(children)...);
+}
+} // namespace cui
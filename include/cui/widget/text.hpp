@@ -20,17 +20,30 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <cui/core/canvas.hpp>
+#include <cui/core/def.hpp>
+#include <cui/core/math.hpp>
 #include <cui/core/node.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
 #include <cui/util/common.h>
+#include <cui/util/fixed_string.hpp>
 
 namespace cui {
 /// A base class for multiple type of text displaying widgets supporting
 /// different string like types
+///
+/// The definitions are available for all string like types, the widgets
+/// for std::string and std::string_view are instantiated by the library.
 template <typename T>
 class TextBase final : public Widget {
+  friend NodeAccess;
+
 public:
   explicit TextBase(T text = {})
     : text_(std::move(text)) {}
@@ -41,6 +54,12 @@ public:
   using Widget::Widget;
   using Widget::operator=;
 
+  /// Sets the displayed text
+  ///
+  /// If the length of a single line text stays the same and its measured
+  /// bounds are unchanged, only the range of changed glyphs is repainted.
+  /// The range is located through the advances of the glyphs,
+  /// \see Surface::glyphAdvance.
   void setText(T text);
 
   T const& text() noexcept {
@@ -53,7 +72,16 @@ protected:
   void paint(Canvas& canvas) const noexcept override;
 
 private:
+  [[nodiscard]] Point advance(Context& context, std::size_t first,
+                              std::size_t last) const noexcept;
+
   T text_;
+  // The range of glyphs changed since the last measuring, which is damaged
+  // on measuring because setText has no access to the Surface.
+  mutable std::size_t first_{0};
+  mutable std::size_t last_{0};
+  // The summed glyph advance of the measured text, or 0 if it is unknown
+  mutable Point advance_{0};
 };
 
 /// An owning text displaying widget
@@ -62,6 +90,109 @@ using Text = TextBase<std::string>;
 /// A non owning text displaying widget
 using TextView = TextBase<std::string_view>;
 
+/// An owning text displaying widget which stores up to N characters inline
+/// without any allocation, \see FixedString
+template <std::size_t N>
+using StaticText = TextBase<FixedString<N>>;
+
+template <typename T>
+void TextBase<T>::setText(T text) {
+  // Single line texts of the same length are likely to keep their bounds.
+  // Relayout boundaries are never measured, thus their damage is unknown.
+  if ((!isLayoutDirty() || (first_ != last_)) && advance_ &&
+      !isRelayoutBoundary() && (text.size() == text_.size()) &&
+      (std::find(text.begin(), text.end(), '\n') == text.end()) &&
+      (std::find(text_.begin(), text_.end(), '\n') == text_.end())) {
+
+    auto const first = std::mismatch(text.begin(), text.end(), text_.begin());
+    if (first.first == text.end()) {
+      text_ = std::move(text);
+      return;
+    }
+
+    auto const last = std::mismatch(text.rbegin(), text.rend(),
+                                    text_.rbegin());
+
+    std::size_t const low = narrow<std::size_t>(first.first - text.begin());
+    std::size_t const high = narrow<std::size_t>(text.rend() - last.first);
+
+    if (first_ != last_) {
+      first_ = std::min(first_, low);
+      last_ = std::max(last_, high);
+    } else {
+      first_ = low;
+      last_ = high;
+    }
+
+    text_ = std::move(text);
+
+    // The damage is known after measuring the glyphs
+    reflow();
+    return;
+  }
+
+  first_ = 0;
+  last_ = 0;
+  text_ = std::move(text);
+
+  reflow();
+  repaint();
+}
+
+template <typename T>
+Vec2 TextBase<T>::preferredSize(Context& context) const noexcept {
+  Vec2 const size = min(constraints(), context.stringBounds(text_));
+
+  Point const previous = std::exchange(advance_,
+                                       advance(context, 0, text_.size()));
+
+  if (first_ != last_) {
+    std::size_t const first = std::exchange(first_, 0);
+    std::size_t const last = std::exchange(last_, 0);
+
+    // A resized text is repainted as a whole when its area is changed
+    if (size == area().size()) {
+      if (previous && advance_) {
+        // The glyphs in front of and behind the changed range are the same,
+        // thus they keep their position if the summed advance is the same
+        Point const low = advance(context, 0, first);
+        Point const high = (previous == advance_)
+                               ? advance(context, 0, last)
+                               : size.x;
+
+        Rect const damage{{low, 0}, {narrow<Point>(high - 1),
+                                     narrow<Point>(size.y - 1)}};
+
+        // The font metrics are only accessible while measuring
+        const_cast<TextBase&>(*this).repaint(damage.clip(Rect::with(size)));
+      } else {
+        const_cast<TextBase&>(*this).repaint();
+      }
+    }
+  }
+
+  return size;
+}
+
+template <typename T>
+Point TextBase<T>::advance(Context& context, std::size_t first,
+                           std::size_t last) const noexcept {
+  Point result = 0;
+  for (std::size_t i = first; i != last; ++i) {
+    Point const current = context.glyphAdvance(text_[i]);
+    if (!current) {
+      return 0;
+    }
+    result = narrow<Point>(result + current);
+  }
+  return result;
+}
+
+template <typename T>
+void TextBase<T>::paint(Canvas& canvas) const noexcept {
+  canvas.drawText({0, 0}, text_);
+}
+
 extern template class CUI_API TextBase<std::string>;
 extern template class CUI_API TextBase<std::string_view>;
 } // namespace cui
@@ -20,23 +20,18 @@
 
 #include <chrono>
 #include <cui/component/animation.hpp>
+#include <cui/component/registry.hpp>
 #include <cui/core/algorithm.hpp>
 #include <cui/core/component.hpp>
 #include <cui/core/traverse.hpp>
 
 namespace cui {
 Delta animate(Node& node, Delta diff) noexcept {
-  // TODO This can heavily improved by caching the AnimationComponent objects
-  //      inside the tree on the root. This was not implemented due to time
-  //      constraints.
-
   Delta minimum = std::chrono::hours(24);
 
-  for (Node& current : visit(node)) {
-    for (AnimationComponent& anim : each<AnimationComponent>(current)) {
-      minimum = min(minimum, anim(diff));
-    }
-  }
+  visit_components<AnimationComponent>(node, [&](AnimationComponent& anim) {
+    minimum = min(minimum, anim(diff));
+  });
 
   return minimum;
 }
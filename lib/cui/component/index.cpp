@@ -0,0 +1,110 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <algorithm>
+#include <cstdint>
+#include <cui/component/index.hpp>
+#include <cui/core/detail/offset.hpp>
+#include <cui/core/node.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+ComponentIndexBase::ComponentIndexBase(Node& owner, Entry* entries,
+                                       std::size_t capacity) noexcept
+  : Component(type_of<ComponentIndexBase>(), owner)
+  , entries_offset_(detail::offset_between(this, entries))
+  , capacity_(static_cast<std::uint8_t>(capacity)) {
+  CUI_ASSERT(owner.components().front() == *this &&
+             "The Node carries Components with reserved TypeIDs!");
+}
+
+void ComponentIndexBase::rebuild() noexcept {
+  Node const& node = owner();
+
+  size_ = 0;
+  complete_ = true;
+
+  // The Components are sorted by their TypeID already
+  for (Component const& component : node.components()) {
+    if (component.type() != type()) {
+      if (size_ == capacity_) {
+        complete_ = false;
+        return;
+      }
+
+      entries()[size_++] = {component.type(),
+                            detail::offset_between(&node, &component)};
+    }
+  }
+}
+
+Component* ComponentIndexBase::find(TypeID type) const noexcept {
+  if (type == this->type()) {
+    return const_cast<ComponentIndexBase*>(this);
+  }
+
+  Entry const* const begin = entries();
+  Entry const* const end = begin + size_;
+
+  Entry const* const entry = std::lower_bound(
+      begin, end, type, [](Entry const& left, TypeID right) {
+        return left.type < right;
+      });
+
+  if ((entry != end) && (entry->type == type)) {
+    std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(&owner()) +
+                               entry->offset;
+    return reinterpret_cast<Component*>(pos);
+  } else {
+    return nullptr;
+  }
+}
+
+void ComponentIndexBase::insert(TypeID type, Offset offset) noexcept {
+  Entry* const begin = entries();
+  Entry* const end = begin + size_;
+
+  Entry* const entry = std::lower_bound(begin, end, type,
+                                        [](Entry const& left, TypeID right) {
+                                          return left.type < right;
+                                        });
+
+  if ((entry != end) && (entry->type == type)) {
+    // Further Components of a TypeID are never inserted before the first one
+    return;
+  }
+
+  if (size_ == capacity_) {
+    complete_ = false;
+    return;
+  }
+
+  std::copy_backward(entry, end, end + 1);
+  *entry = {type, offset};
+  ++size_;
+}
+
+ComponentIndexBase::Entry* ComponentIndexBase::entries() const noexcept {
+  std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(this) +
+                             entries_offset_;
+  return reinterpret_cast<Entry*>(pos);
+}
+} // namespace cui
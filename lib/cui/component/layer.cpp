@@ -0,0 +1,72 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <utility>
+#include <cui/component/layer.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/surface.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/casting.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+LayerComponent::LayerComponent(Node& owner) noexcept
+  : Component(type_of<LayerComponent>(), owner) {
+  CUI_ASSERT(isa<Container>(owner));
+}
+
+LayerComponent::LayerComponent(LayerComponent&& other) noexcept
+  : Component(std::move(other)) {}
+
+LayerComponent& LayerComponent::operator=(LayerComponent&& other) noexcept {
+  Component::operator=(std::move(other));
+
+  valid_ = false;
+  return *this;
+}
+
+bool LayerComponent::prepare(Surface& surface, Vec2 translation,
+                             Rect const& visible) noexcept {
+  // Only the part of the owner which is shown on the Surface is retained
+  Rect const area = Rect::ofIntersect(visible,
+                                      Rect::with(surface.resolution()));
+  Rect const local = area - translation;
+
+  // Dirty Nodes are not always reported to the layer, for instance when
+  // their paint state is not cleared by full paints.
+  Container const& container = cast<Container>(owner());
+  bool const dirty = container.isPaintDirty() || container.isChildPaintDirty();
+
+  if (valid_ && !dirty && (recorded_ == local)) {
+    return true;
+  }
+
+  valid_ = area && record(surface, area);
+  recorded_ = local;
+  return valid_;
+}
+
+void LayerComponent::composite(Surface& surface, Vec2 translation,
+                               Rect const& clip) noexcept {
+  CUI_ASSERT(valid_);
+
+  draw(surface, recorded_ + translation, clip);
+}
+} // namespace cui
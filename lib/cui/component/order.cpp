@@ -0,0 +1,133 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <cui/component/order.hpp>
+#include <cui/core/algorithm.hpp>
+#include <cui/core/detail/offset.hpp>
+#include <cui/core/node.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/casting.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+SiblingOrderBase::SiblingOrderBase(Container& owner, Node const** entries,
+                                   std::size_t capacity) noexcept
+  : Component(type_of<SiblingOrderBase>(), owner)
+  , entries_offset_(detail::offset_between(this, entries))
+  , capacity_(static_cast<std::uint16_t>(capacity)) {}
+
+SiblingOrderBase::SiblingOrderBase(SiblingOrderBase&& other) noexcept
+  : Component(std::move(other))
+  , entries_offset_(other.entries_offset_)
+  , capacity_(other.capacity_) {}
+
+SiblingOrderBase&
+SiblingOrderBase::operator=(SiblingOrderBase&& other) noexcept {
+  Component::operator=(std::move(other));
+
+  CUI_ASSERT(capacity_ == other.capacity_);
+
+  invalidate();
+  return *this;
+}
+
+bool SiblingOrderBase::available() noexcept {
+  Node const** const entries = data();
+
+  if (stale_) {
+    stale_ = false;
+    unsorted_ = true;
+    overflowed_ = false;
+    size_ = 0;
+
+    for (Node const& child : cast<Container>(owner()).children()) {
+      if (size_ == capacity_) {
+        overflowed_ = true;
+        break;
+      }
+
+      entries[size_++] = &child;
+    }
+  }
+
+  if (overflowed_) {
+    return false;
+  }
+
+  if (unsorted_) {
+    unsorted_ = false;
+    widest_ = 0;
+
+    // An insertion sort is linear for the mostly sorted previous order
+    for (std::size_t i = 0; i < size_; ++i) {
+      Node const* const current = entries[i];
+      Point const low = current->area().low.x;
+      widest_ = max(widest_, current->area().width());
+
+      std::size_t j = i;
+      for (; (j > 0) && (entries[j - 1]->area().low.x > low); --j) {
+        entries[j] = entries[j - 1];
+      }
+      entries[j] = current;
+    }
+  }
+
+  return true;
+}
+
+Span<Node const* const> SiblingOrderBase::entries() const noexcept {
+  CUI_ASSERT(!isStale() && !overflowed_);
+  return {data(), size_};
+}
+
+bool SiblingOrderBase::collides(Node const& child) const noexcept {
+  CUI_ASSERT(!isStale() && !overflowed_);
+  CUI_ASSERT(child.parent() == &owner());
+
+  Node const* const* const begin = data();
+  Node const* const* const end = begin + size_;
+  Rect const area = child.area();
+
+  // Siblings starting further left than the widest child can't reach it
+  auto const from = area.low.x - widest_ + 1;
+  Node const* const* current = std::lower_bound(
+      begin, end, from, [](Node const* sibling, decltype(from) x) {
+        return sibling->area().low.x < x;
+      });
+
+  for (; (current != end) && ((*current)->area().low.x <= area.high.x);
+       ++current) {
+    if ((*current != &child) && cui::collides(child, **current)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+Node const** SiblingOrderBase::data() const noexcept {
+  std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(this) +
+                             entries_offset_;
+  return reinterpret_cast<Node const**>(pos);
+}
+} // namespace cui
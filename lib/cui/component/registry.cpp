@@ -0,0 +1,142 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <cui/component/registry.hpp>
+#include <cui/core/detail/offset.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/traverse.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+RegistryComponent::RegistryComponent(Node& owner, TypeID registered,
+                                     Component** entries,
+                                     std::size_t capacity) noexcept
+  : Component(type_of<RegistryComponent>(), owner)
+  , registered_(registered)
+  , entries_offset_(detail::offset_between(this, entries))
+  , capacity_(static_cast<std::uint8_t>(capacity)) {
+  CUI_ASSERT(registered_ != type());
+}
+
+RegistryComponent::RegistryComponent(RegistryComponent&& other) noexcept
+  : Component(std::move(other))
+  , registered_(other.registered_)
+  , entries_offset_(other.entries_offset_)
+  , capacity_(other.capacity_) {}
+
+RegistryComponent&
+RegistryComponent::operator=(RegistryComponent&& other) noexcept {
+  Component::operator=(std::move(other));
+
+  CUI_ASSERT(registered_ == other.registered_);
+  CUI_ASSERT(capacity_ == other.capacity_);
+
+  stale_ = true;
+  return *this;
+}
+
+bool RegistryComponent::complete() noexcept {
+  if (stale_) {
+    rebuild();
+  }
+
+  return !overflowed_;
+}
+
+Range<Component* const*> RegistryComponent::entries() noexcept {
+  if (stale_) {
+    rebuild();
+  }
+
+  return {data(), data() + size_};
+}
+
+void RegistryComponent::attach(Node& subtree) noexcept {
+  for (Node& current : visit(subtree)) {
+    if (current.contains(registered_)) {
+      for (Component& component : current.find(registered_)->siblings()) {
+        add(component);
+      }
+    }
+  }
+}
+
+void RegistryComponent::detach(Node& subtree) noexcept {
+  for (Node& current : visit(subtree)) {
+    if (current.contains(registered_)) {
+      for (Component& component : current.find(registered_)->siblings()) {
+        remove(component);
+      }
+    }
+  }
+}
+
+void RegistryComponent::add(Component& component) noexcept {
+  CUI_ASSERT(component.type() == registered_);
+
+  if (stale_) {
+    // Picked up by the next rebuild
+    return;
+  }
+
+  if (size_ == capacity_) {
+    overflowed_ = true;
+    return;
+  }
+
+  data()[size_++] = &component;
+}
+
+void RegistryComponent::remove(Component& component) noexcept {
+  if (stale_) {
+    return;
+  }
+
+  if (overflowed_) {
+    // The registry might be able to hold all Components again
+    stale_ = true;
+    return;
+  }
+
+  Component** const begin = data();
+  Component** const end = begin + size_;
+
+  Component** const last = std::remove(begin, end, &component);
+  size_ = static_cast<std::uint8_t>(last - begin);
+}
+
+void RegistryComponent::rebuild() noexcept {
+  size_ = 0;
+  stale_ = false;
+  overflowed_ = false;
+
+  attach(owner());
+}
+
+Component** RegistryComponent::data() const noexcept {
+  std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(this) +
+                             entries_offset_;
+  return reinterpret_cast<Component**>(pos);
+}
+} // namespace cui
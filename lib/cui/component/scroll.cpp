@@ -0,0 +1,77 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <utility>
+#include <cui/component/scroll.hpp>
+#include <cui/core/math.hpp>
+#include <cui/core/node.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/casting.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+ScrollComponent::ScrollComponent(Node& owner) noexcept
+  : Component(type_of<ScrollComponent>(), owner) {
+  CUI_ASSERT(isa<Container>(owner));
+}
+
+ScrollComponent::ScrollComponent(ScrollComponent&& other) noexcept
+  : Component(std::move(other))
+  , invalid_(true) {}
+
+ScrollComponent& ScrollComponent::operator=(ScrollComponent&& other) noexcept {
+  Component::operator=(std::move(other));
+
+  invalidate();
+  return *this;
+}
+
+std::size_t ScrollComponent::exposed(Rect const& area, Vec2 offset,
+                                     Rect (&strips)[2]) noexcept {
+  if ((abs(offset.x) >= area.width()) || (abs(offset.y) >= area.height())) {
+    strips[0] = area;
+    return 1;
+  }
+
+  std::size_t count = 0;
+
+  if (offset.y > 0) {
+    strips[count++] = {area.low,
+                       {area.high.x,
+                        static_cast<Point>(area.low.y + offset.y - 1)}};
+  } else if (offset.y < 0) {
+    strips[count++] = {{area.low.x,
+                        static_cast<Point>(area.high.y + offset.y + 1)},
+                       area.high};
+  }
+
+  if (offset.x > 0) {
+    strips[count++] = {area.low,
+                       {static_cast<Point>(area.low.x + offset.x - 1),
+                        area.high.y}};
+  } else if (offset.x < 0) {
+    strips[count++] = {{static_cast<Point>(area.high.x + offset.x + 1),
+                        area.low.y},
+                       area.high};
+  }
+
+  return count;
+}
+} // namespace cui
@@ -0,0 +1,87 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <utility>
+#include <cui/component/spatial.hpp>
+#include <cui/core/arena.hpp>
+#include <cui/core/grid.hpp>
+#include <cui/core/node.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+SpatialIndex::SpatialIndex(Node& owner, NodeArena& arena,
+                           SpatialGrid& grid) noexcept
+  : Component(type_of<SpatialIndex>(), owner)
+  , arena_(&arena)
+  , grid_(&grid) {}
+
+SpatialIndex::SpatialIndex(SpatialIndex&& other) noexcept
+  : Component(std::move(other))
+  , arena_(other.arena_)
+  , grid_(other.grid_) {}
+
+SpatialIndex& SpatialIndex::operator=(SpatialIndex&& other) noexcept {
+  Component::operator=(std::move(other));
+
+  arena_ = other.arena_;
+  grid_ = other.grid_;
+  stale_ = true;
+  return *this;
+}
+
+bool SpatialIndex::available() noexcept {
+  if (stale_) {
+    stale_ = false;
+    moved_ = true;
+
+    // An overflowed arena stays empty until the tree changes again
+    arena_->assign(owner());
+  }
+
+  if (arena_->empty()) {
+    return false;
+  }
+
+  if (moved_) {
+    moved_ = false;
+
+    arena_->refresh();
+
+    // An overflowed grid falls back to the arena
+    grid_->build(*arena_);
+  }
+
+  return true;
+}
+
+Node* SpatialIndex::intersection(Vec2 position) noexcept {
+  CUI_ASSERT(!stale_ && !moved_);
+
+  NodeArena::Index const index = grid_->valid()
+                                     ? grid_->intersection(*arena_, position)
+                                     : arena_->intersection(position);
+
+  if (index == NodeArena::npos) {
+    return nullptr;
+  }
+
+  return &arena_->node(index);
+}
+} // namespace cui
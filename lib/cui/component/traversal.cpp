@@ -0,0 +1,65 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <utility>
+#include <cui/component/traversal.hpp>
+#include <cui/core/arena.hpp>
+#include <cui/core/node.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+TraversalCache::TraversalCache(Node& owner, NodeArena& arena) noexcept
+  : Component(type_of<TraversalCache>(), owner)
+  , arena_(&arena) {}
+
+TraversalCache::TraversalCache(TraversalCache&& other) noexcept
+  : Component(std::move(other))
+  , arena_(other.arena_) {}
+
+TraversalCache& TraversalCache::operator=(TraversalCache&& other) noexcept {
+  Component::operator=(std::move(other));
+
+  arena_ = other.arena_;
+  stale_ = true;
+  return *this;
+}
+
+NodeArena* TraversalCache::arena() noexcept {
+  if (stale_) {
+    stale_ = false;
+    moved_ = true;
+
+    // An overflowed arena stays empty until the tree changes again
+    arena_->assign(owner());
+  }
+
+  if (arena_->empty()) {
+    return nullptr;
+  }
+
+  if (moved_) {
+    moved_ = false;
+
+    arena_->refresh();
+  }
+
+  return arena_;
+}
+} // namespace cui
@@ -0,0 +1,125 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstdint>
+#include <utility>
+#include <cui/component/worklist.hpp>
+#include <cui/core/detail/offset.hpp>
+#include <cui/core/node.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/util/type_of.hpp>
+
+namespace cui {
+PaintWorklistBase::PaintWorklistBase(Node& owner, Node** entries,
+                                     std::size_t capacity, Rect* damage,
+                                     std::size_t damage_capacity) noexcept
+  : Component(type_of<PaintWorklistBase>(), owner)
+  , entries_offset_(detail::offset_between(this, entries))
+  , damage_offset_(detail::offset_between(this, damage))
+  , capacity_(static_cast<std::uint16_t>(capacity))
+  , damage_capacity_(static_cast<std::uint8_t>(damage_capacity)) {}
+
+PaintWorklistBase::PaintWorklistBase(PaintWorklistBase&& other) noexcept
+  : Component(std::move(other))
+  , entries_offset_(other.entries_offset_)
+  , damage_offset_(other.damage_offset_)
+  , capacity_(other.capacity_)
+  , damage_size_(other.damage_size_)
+  , damage_capacity_(other.damage_capacity_) {}
+
+PaintWorklistBase&
+PaintWorklistBase::operator=(PaintWorklistBase&& other) noexcept {
+  Component::operator=(std::move(other));
+
+  CUI_ASSERT(capacity_ == other.capacity_);
+  CUI_ASSERT(damage_capacity_ == other.damage_capacity_);
+
+  // The damage is not painted yet and stays recorded
+  damage_size_ = other.damage_size_;
+
+  invalidate();
+  return *this;
+}
+
+Range<Node* const*> PaintWorklistBase::entries() const noexcept {
+  return {data(), data() + size_};
+}
+
+Range<Rect const*> PaintWorklistBase::damage() const noexcept {
+  return {damage_data(), damage_data() + damage_size_};
+}
+
+void PaintWorklistBase::clear() noexcept {
+  size_ = 0;
+  damage_size_ = 0;
+  complete_ = true;
+}
+
+void PaintWorklistBase::invalidate() noexcept {
+  size_ = 0;
+  complete_ = false;
+}
+
+void PaintWorklistBase::push(Node& node) noexcept {
+  if (!complete_) {
+    return;
+  }
+
+  if (size_ == capacity_) {
+    invalidate();
+    return;
+  }
+
+  data()[size_++] = &node;
+}
+
+bool PaintWorklistBase::record(Rect const& area) noexcept {
+  if (!area) {
+    return true;
+  }
+
+  Rect* const damage = damage_data();
+  for (std::uint8_t i = 0; i < damage_size_; ++i) {
+    if (damage[i].overlaps(area)) {
+      damage[i] = Rect::ofUnion(damage[i], area);
+      return true;
+    }
+  }
+
+  if (damage_size_ == damage_capacity_) {
+    return false;
+  }
+
+  damage[damage_size_++] = area;
+  return true;
+}
+
+Node** PaintWorklistBase::data() const noexcept {
+  std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(this) +
+                             entries_offset_;
+  return reinterpret_cast<Node**>(pos);
+}
+
+Rect* PaintWorklistBase::damage_data() const noexcept {
+  std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(this) +
+                             damage_offset_;
+  return reinterpret_cast<Rect*>(pos);
+}
+} // namespace cui
@@ -18,12 +18,16 @@
   along with this program. If not, see <https://www.gnu.org/licenses/>.
 **/
 
-#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include <cui/component/order.hpp>
+#include <cui/component/spatial.hpp>
 #include <cui/core/access.hpp>
 #include <cui/core/algorithm.hpp>
 #include <cui/core/canvas.hpp>
 #include <cui/core/detail/pipeline_impl.hpp>
 #include <cui/core/node.hpp>
+#include <cui/core/pipeline.hpp>
 #include <cui/core/rect.hpp>
 #include <cui/core/traverse.hpp>
 #include <cui/core/vector.hpp>
@@ -83,6 +87,12 @@ bool is_transitive_parent(Node& parent, Node& child) noexcept {
 }
 
 Node const* intersection(Node const& node, Vec2 position) noexcept {
+  if (SpatialIndex* index = any<SpatialIndex>(const_cast<Node&>(node))) {
+    if (index->available()) {
+      return index->intersection(position);
+    }
+  }
+
   for (Accept& current : traverse(const_cast<Node&>(node))) {
     if (current.isPre()) {
       if (!current->clipSpace().contains(position)) {
@@ -107,41 +117,76 @@ bool collides(Node const& node) noexcept {
     return false;
   }
 
-  Rect const clip = Rect::with(node.parent()->area().size());
-  Rect const area = node.area();
-  auto const siblings = node.siblings();
-
-  if (!clip.overlaps(area)) {
+  Container const& parent = *node.parent();
+  if (!Rect::with(parent.area().size()).overlaps(node.area())) {
     return false;
   }
 
-  // Check all siblings on the right hand side
-  for (Node const& sibling : siblings) {
-    if (clip.overlaps(sibling.area()) && area.overlaps(sibling.area())) {
-      if (!isa<Widget>(node) || !isa<Widget>(sibling) ||
-          (cast<Widget>(node).collides(sibling.area()) &&
-           cast<Widget>(sibling).collides(area))) {
-        return true;
-      }
+  if (auto* order = any<SiblingOrderBase>(const_cast<Container&>(parent))) {
+    if (order->available()) {
+      return order->collides(node);
     }
   }
 
-  // Check all siblings on the left hand side
-  for (Node const& sibling :
-       Range(std::make_reverse_iterator(siblings.begin()),
-             std::make_reverse_iterator(siblings.end()))) {
-    if (clip.overlaps(sibling.area()) && area.overlaps(sibling.area())) {
-      if (!isa<Widget>(node) || !isa<Widget>(sibling) ||
-          (cast<Widget>(node).collides(sibling.area()) &&
-           cast<Widget>(sibling).collides(area))) {
-        return true;
-      }
+  for (Node const& sibling : parent.children()) {
+    if ((&sibling != &node) && collides(node, sibling)) {
+      return true;
     }
   }
 
   return false;
 }
 
+bool collides(Node const& left, Node const& right) noexcept {
+  CUI_ASSERT(left.parent() == right.parent());
+  CUI_ASSERT(left.parent());
+
+  Rect const clip = Rect::with(left.parent()->area().size());
+  Rect const first = left.area();
+  Rect const second = right.area();
+
+  if (!clip.overlaps(first) || !clip.overlaps(second) ||
+      !first.overlaps(second)) {
+    return false;
+  }
+
+  return !isa<Widget>(left) || !isa<Widget>(right) ||
+         (cast<Widget>(left).collides(second) &&
+          cast<Widget>(right).collides(first));
+}
+
+namespace detail {
+Span<Node const* const> sibling_order(Container const& container) noexcept {
+  if (auto* order = any<SiblingOrderBase>(const_cast<Container&>(container))) {
+    if (order->available()) {
+      return order->entries();
+    }
+  }
+  return {};
+}
+
+std::size_t sort_children(Container const& container,
+                          Span<Node const*> storage) noexcept {
+  std::size_t size = 0;
+
+  for (Node const& child : container.children()) {
+    if (size < storage.size()) {
+      storage[size] = &child;
+    }
+    ++size;
+  }
+
+  if (size <= storage.size()) {
+    std::sort(storage.data(), storage.data() + size,
+              [](Node const* left, Node const* right) {
+                return left->area().low.x < right->area().low.x;
+              });
+  }
+
+  return size;
+}
+} // namespace detail
+
 void reset(Node& node) noexcept {
   // Reflow everything if the surface has changed
   NodeAccess::reflow(node);
@@ -174,22 +219,29 @@ static bool layout_init(Node& node, Surface& surface) noexcept {
   return true;
 }
 
-static bool layout_end(Context& context, Node& node, Node& current) noexcept {
+static bool layout_end(Context& context, Node& node, Node& current,
+                       bool root) noexcept {
   if (Container* container = dyn_cast<Container>(current)) {
     Vec2 const size = NodeAccess::onLayoutEnd(*container, context);
     CUI_ASSERT(size.x >= 0);
     CUI_ASSERT(size.y >= 0);
 
-    if (*current != node) {
+    if (((*current != node) || !root) && !current.isRelayoutBoundary()) {
       return current.setSize(size);
     } else {
+      // The size of roots and boundaries never affects their parents
       (void)size;
       current.setSize(current.constraints());
       return false;
     }
   } else {
     CUI_ASSERT(isa<Widget>(*current));
-    CUI_ASSERT(current != node);
+    CUI_ASSERT((current != node) || !root);
+
+    if (current.isRelayoutBoundary()) {
+      current.setSize(current.constraints());
+      return false;
+    }
 
     Vec2 const size = cast<Widget>(*current).preferredSize(context);
     CUI_ASSERT(size.x >= 0);
@@ -209,6 +261,89 @@ void layout(Node& node, Surface& surface) noexcept {
   }
 
   Context context(surface);
+  detail::layout_nodes(context, node, true);
+}
+
+/// Returns the count of direct children of the given Node
+static std::size_t children_of(Node const& node) noexcept {
+  std::size_t size = 0;
+  if (Container const* container = dyn_cast<Container>(&node)) {
+    for (Node const& child : container->children()) {
+      (void)child;
+      ++size;
+    }
+  }
+  return size;
+}
+
+std::size_t capture_layout(Node const& node,
+                           Span<LayoutRecord> records) noexcept {
+  std::size_t size = 0;
+
+  for (Accept& current : traverse(const_cast<Node&>(node))) {
+    if (current.isPre()) {
+      if (size < records.size()) {
+        records[size] = {current->constraints(), current->area(),
+                         current->kind(), children_of(*current)};
+      }
+      ++size;
+    }
+  }
+
+  return size;
+}
+
+bool adopt_layout(Node& node, Surface& surface,
+                  Span<LayoutRecord const> records) noexcept {
+  // Records that were captured from another tree with the same count of Nodes
+  // would be adopted silently otherwise
+  std::size_t size = 0;
+  for (Accept& current : traverse(node)) {
+    if (current.isPre()) {
+      if (size < records.size()) {
+        LayoutRecord const& record = records[size];
+
+        if ((record.kind != current->kind()) ||
+            (record.children != children_of(*current))) {
+          return false;
+        }
+      }
+      ++size;
+    }
+  }
+
+  if (size != records.size()) {
+    return false;
+  }
+
+  if (!node.isAttached() &&
+      (records[0].constraints != surface.resolution())) {
+    return false;
+  }
+
+  if (surface.changed()) {
+    // The layout is up to date but everything needs to be repainted
+    NodeAccess::repaint_all(node);
+  }
+
+  LayoutRecord const* record = records.data();
+  for (Accept& current : traverse(node)) {
+    if (current.isPre()) {
+      current->setConstraints(record->constraints);
+      current->setArea(record->area);
+      ++record;
+    }
+
+    if (current.isPost()) {
+      NodeAccess::clearLayoutDirty(*current);
+    }
+  }
+
+  return true;
+}
+
+bool detail::layout_nodes(Context& context, Node& node, bool root) noexcept {
+  bool resized = false;
 
   for (Accept& current : traverse(node)) {
     while (true) {
@@ -223,6 +358,11 @@ void layout(Node& node, Surface& surface) noexcept {
           current->setConstraints(constraints);
         }
 
+        if ((*current != node) && current->isLayoutCulled()) {
+          current.skip();
+          break; // continue for
+        }
+
         CUI_ASSERT(current->constraints().x >= 0);
         CUI_ASSERT(current->constraints().y >= 0);
 
@@ -242,7 +382,13 @@ void layout(Node& node, Surface& surface) noexcept {
         bool const dirty = current->isLayoutDirty();
         NodeAccess::clearLayoutDirty(*current);
 
-        if (dirty && layout_end(context, node, *current)) {
+        if (dirty && layout_end(context, node, *current, root)) {
+          if (*current == node) {
+            // The parent of the subtree is re-evaluated by the caller
+            resized = true;
+            break; // continue for
+          }
+
           Container* const parent = current->parent();
           CUI_ASSERT(parent);
 
@@ -260,5 +406,7 @@ void layout(Node& node, Surface& surface) noexcept {
       break; // continue for
     }
   }
+
+  return resized;
 }
 } // namespace cui
@@ -0,0 +1,119 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cui/core/access.hpp>
+#include <cui/core/arena.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/traverse.hpp>
+#include <cui/util/assert.hpp>
+
+namespace cui {
+NodeArena::NodeArena(Span<Node*> nodes, Span<Index> parents, Span<Index> ends,
+                     Span<Rect> bounds, Span<Rect> clips) noexcept
+  : nodes_(nodes)
+  , parents_(parents)
+  , ends_(ends)
+  , bounds_(bounds)
+  , clips_(clips) {
+  CUI_ASSERT(parents_.size() >= nodes_.size());
+  CUI_ASSERT(ends_.size() >= nodes_.size());
+  CUI_ASSERT(bounds_.size() >= nodes_.size());
+  CUI_ASSERT(clips_.size() >= nodes_.size());
+  CUI_ASSERT(nodes_.size() < npos);
+}
+
+bool NodeArena::assign(Node& root) noexcept {
+  size_ = 0;
+
+  // The index of the Node whose subtree is currently visited
+  Index open = npos;
+
+  for (Accept& current : traverse(root)) {
+    if (current.isPre()) {
+      if (size_ == capacity()) {
+        clear();
+        return false;
+      }
+
+      Index const index = static_cast<Index>(size_++);
+      nodes_[index] = &(*current);
+      parents_[index] = open;
+      open = index;
+    }
+
+    if (current.isPost()) {
+      CUI_ASSERT(open != npos);
+      CUI_ASSERT(nodes_[open] == &(*current));
+
+      ends_[open] = static_cast<Index>(size_);
+      open = parents_[open];
+    }
+  }
+
+  CUI_ASSERT(open == npos);
+  return true;
+}
+
+void NodeArena::clear() noexcept {
+  size_ = 0;
+}
+
+void NodeArena::refresh() noexcept {
+  for (std::size_t i = 0; i < size_; ++i) {
+    Node& current = *nodes_[i];
+    Rect const area = current.area();
+    Index const parent = parents_[i];
+
+    // Parents always precede their children
+    if (parent == npos) {
+      bounds_[i] = area;
+      clips_[i] = area;
+    } else {
+      CUI_ASSERT(parent < i);
+
+      bounds_[i] = area + bounds_[parent].low;
+      clips_[i] = Rect::ofIntersect(clips_[parent], bounds_[i]);
+    }
+
+    NodeAccess::setClipSpace(current, clips_[i]);
+  }
+}
+
+NodeArena::Index NodeArena::intersection(Vec2 position) const noexcept {
+  if (empty() || !clips_[0].contains(position)) {
+    return npos;
+  }
+
+  Index current = 0;
+  Index child = 1;
+
+  // Descend into the first child that contains the position
+  while (child < ends_[current]) {
+    if (clips_[child].contains(position)) {
+      current = child;
+      ++child;
+    } else {
+      child = ends_[child];
+    }
+  }
+
+  return current;
+}
+} // namespace cui
@@ -0,0 +1,35 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <cui/core/component.hpp>
+#include <cui/core/math.hpp>
+
+namespace cui::detail {
+/// Returns the relocatable offset between the given objects
+inline Component::Offset offset_between(void const* from,
+                                        void const* to) noexcept {
+  return narrow<Component::Offset>(
+      narrow<std::intptr_t>(reinterpret_cast<std::uintptr_t>(to)) -
+      narrow<std::intptr_t>(reinterpret_cast<std::uintptr_t>(from)));
+}
+} // namespace cui::detail
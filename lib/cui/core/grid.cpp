@@ -0,0 +1,171 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstddef>
+#include <cui/core/arena.hpp>
+#include <cui/core/grid.hpp>
+#include <cui/core/math.hpp>
+#include <cui/util/assert.hpp>
+
+namespace cui {
+SpatialGrid::SpatialGrid(Span<Index> cells, Span<Index> entries,
+                         std::size_t columns, std::size_t rows) noexcept
+  : cells_(cells)
+  , entries_(entries)
+  , columns_(columns)
+  , rows_(rows) {
+  CUI_ASSERT(columns_ > 0);
+  CUI_ASSERT(rows_ > 0);
+  CUI_ASSERT(cells_.size() > columns_ * rows_);
+}
+
+bool SpatialGrid::build(NodeArena const& arena) noexcept {
+  std::size_t const count = columns_ * rows_;
+
+  for (std::size_t cell = 0; cell <= count; ++cell) {
+    cells_[cell] = 0;
+  }
+
+  bounds_ = arena.empty() ? Rect::none() : arena.clip(0);
+
+  if (bounds_.empty()) {
+    valid_ = true;
+    return true;
+  }
+
+  Vec2 const size = bounds_.size();
+  Point const columns = static_cast<Point>(columns_);
+  Point const rows = static_cast<Point>(rows_);
+  cell_ = {static_cast<Point>((size.x + columns - 1) / columns),
+           static_cast<Point>((size.y + rows - 1) / rows)};
+
+  // Count the entries of every cell
+  std::size_t total = 0;
+  for (Index i = 0; i < arena.size(); ++i) {
+    Rect const clip = arena.clip(i);
+    if (clip.empty()) {
+      continue;
+    }
+
+    Rect const cells = range(clip);
+    for (Point y = cells.low.y; y <= cells.high.y; ++y) {
+      for (Point x = cells.low.x; x <= cells.high.x; ++x) {
+        ++cells_[index(Vec2{x, y})];
+        ++total;
+      }
+    }
+  }
+
+  if (total > entries_.size()) {
+    clear();
+    return false;
+  }
+
+  // Turn the counts into the offsets of the cells
+  Index offset = 0;
+  for (std::size_t cell = 0; cell < count; ++cell) {
+    Index const current = cells_[cell];
+    cells_[cell] = offset;
+    offset += current;
+  }
+
+  // Nodes are appended in pre-order, which advances every offset
+  // to the beginning of the next cell
+  for (Index i = 0; i < arena.size(); ++i) {
+    Rect const clip = arena.clip(i);
+    if (clip.empty()) {
+      continue;
+    }
+
+    Rect const cells = range(clip);
+    for (Point y = cells.low.y; y <= cells.high.y; ++y) {
+      for (Point x = cells.low.x; x <= cells.high.x; ++x) {
+        entries_[cells_[index(Vec2{x, y})]++] = i;
+      }
+    }
+  }
+
+  for (std::size_t cell = count; cell > 0; --cell) {
+    cells_[cell] = cells_[cell - 1];
+  }
+  cells_[0] = 0;
+
+  CUI_ASSERT(cells_[count] == total);
+
+  valid_ = true;
+  return true;
+}
+
+void SpatialGrid::clear() noexcept {
+  valid_ = false;
+}
+
+SpatialGrid::Index SpatialGrid::intersection(NodeArena const& arena,
+                                             Vec2 position) const noexcept {
+  CUI_ASSERT(valid_);
+
+  if (!bounds_.contains(position)) {
+    return NodeArena::npos;
+  }
+
+  std::size_t const cell = index(range(Rect{position, position}).low);
+
+  // The root contains the position, every further Node is only a candidate
+  // if it is a child of the currently deepest Node containing the position
+  Index current = 0;
+
+  for (Index i = cells_[cell]; i < cells_[cell + 1]; ++i) {
+    Index const entry = entries_[i];
+
+    if (entry <= current) {
+      continue;
+    }
+    if (entry >= arena.end(current)) {
+      break;
+    }
+
+    if ((arena.parent(entry) == current) &&
+        arena.clip(entry).contains(position)) {
+      current = entry;
+    }
+  }
+
+  return current;
+}
+
+Rect SpatialGrid::range(Rect const& area) const noexcept {
+  CUI_ASSERT(bounds_.contains(area));
+
+  Vec2 const low = area.low - bounds_.low;
+  Vec2 const high = area.high - bounds_.low;
+
+  // Cells are counted in whole units regardless of the Point type
+  auto const column = [&](Point x) {
+    return static_cast<Point>(
+        min(static_cast<std::size_t>(x / cell_.x), columns_ - 1));
+  };
+  auto const row = [&](Point y) {
+    return static_cast<Point>(
+        min(static_cast<std::size_t>(y / cell_.y), rows_ - 1));
+  };
+
+  return {{column(low.x), row(low.y)}, {column(high.x), row(high.y)}};
+}
+} // namespace cui
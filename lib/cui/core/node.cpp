@@ -21,13 +21,22 @@
 #include <cstdlib>
 #include <type_traits>
 #include <utility>
+#include <cui/component/index.hpp>
+#include <cui/component/layer.hpp>
 #include <cui/component/mount.hpp>
+#include <cui/component/registry.hpp>
+#include <cui/component/scroll.hpp>
+#include <cui/component/order.hpp>
+#include <cui/component/spatial.hpp>
+#include <cui/component/traversal.hpp>
+#include <cui/component/worklist.hpp>
 #include <cui/core/access.hpp>
 #include <cui/core/algorithm.hpp>
 #include <cui/core/component.hpp>
 #include <cui/core/detail/for_each.hpp>
 #include <cui/core/node.hpp>
 #include <cui/core/traverse.hpp>
+#include <cui/util/type_of.hpp>
 
 namespace cui {
 static_assert(sizeof(Component) == 8);
@@ -77,6 +86,16 @@ struct NodeImpl {
                (node.prev_sibling_ != node.next_sibling_));
     CUI_ASSERT(!node.prev_sibling_ || node.parent_);
     CUI_ASSERT(!node.next_sibling_ || node.parent_);
+
+    if (node.parent_) {
+      // The Components of the Node were moved as well
+      registries(*node.parent_, [](RegistryComponent& registry) {
+        registry.stale_ = true;
+      });
+
+      invalidateStructure(*node.parent_);
+      invalidateOrder(*node.parent_, true);
+    }
   }
 
   static void flag_parent_child_paint_dirty(Node& node) noexcept {
@@ -99,18 +118,121 @@ struct NodeImpl {
     }
   }
 
-  static void repaint_repositioned(Node& node) noexcept {
+  /// Returns true if the Node retains its painted content in valid layers
+  static bool isRetained(Node& node) noexcept {
+    constexpr TypeID type = type_of<LayerComponent>();
+
+    if (!node.contains(type)) {
+      return false;
+    }
+
+    for (Component& component : node.find(type)->siblings()) {
+      if (!static_cast<LayerComponent&>(component).isValid()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Repaints a moved Node at its new area and records the area it was
+  /// painted at before as damage on the worklist of its root
+  ///
+  /// A repaint boundary that was moved without being resized records its new
+  /// area as damage as well instead of becoming dirty, such that its retained
+  /// layer is composited at the new area and not recorded again.
+  ///
+  /// \returns false if the parent has to be repainted instead
+  static bool repaint_moved(Node& node, bool resized) noexcept {
+    constexpr TypeID type = type_of<PaintWorklistBase>();
+
+    CUI_ASSERT(node.parent_);
+
+    // A dirty parent paints the vacated area anyway
+    if (node.parent_->isPaintDirty()) {
+      return false;
+    }
+
+    Node* root = node.parent_;
+    while (root->parent_) {
+      root = root->parent_;
+    }
+
+    if (!root->contains(type)) {
+      return false;
+    }
+
+    if (!resized && !node.isPaintDirty() && isRetained(node)) {
+      Rect const area = absolute(node).clip;
+
+      for (Component& component : root->find(type)->siblings()) {
+        auto& worklist = static_cast<PaintWorklistBase&>(component);
+
+        if (!worklist.record(node.clip_space_) || !worklist.record(area)) {
+          return false;
+        }
+      }
+
+      // The layers of the parents retain the Node at its previous area
+      for (Node* current = node.parent_; current; current = current->parent_) {
+        invalidateLayers(*current);
+      }
+      return true;
+    }
+
+    // The clip space is the one of the last paint as long as the Node
+    // was not repainted since it was moved first
+    if (!node.has(Flag::PaintMoved)) {
+      for (Component& component : root->find(type)->siblings()) {
+        if (!static_cast<PaintWorklistBase&>(component).record(
+                node.clip_space_)) {
+          return false;
+        }
+      }
+
+      set(node, Flag::PaintMoved);
+    }
+
+    if (!node.isPaintDirty()) {
+      set(node, Flag::PaintDirty);
+      flag_parent_child_paint_dirty(node);
+      enqueuePaint(node);
+    }
+    return true;
+  }
+
+  static void repaint_repositioned(Node& node, bool resized) noexcept {
+    invalidateIndices(node);
+
+    // The Node is repainted entirely at its new area
+    if (isa<Widget>(node)) {
+      unset(node, Flag::PaintDamaged);
+    }
+
+    if (node.parent_) {
+      invalidateOrder(*node.parent_, false);
+
+      if (repaint_moved(node, resized)) {
+        return;
+      }
+    }
+
     if (node.parent()) {
       if (!node.parent()->isPaintDirty()) {
         flag_parent_child_paint_dirty(*node.parent());
 
         set(*node.parent(), Flag::PaintDirty | Flag::PaintRepositioned);
+        enqueuePaint(*node.parent());
       } else if (!node.parent()->isPaintRepositioned()) {
         set(*node.parent(), Flag::PaintDirty | Flag::PaintRepositioned);
       }
     } else {
       if (!node.isPaintRepositioned()) {
+        bool const dirty = node.isPaintDirty();
         set(node, Flag::PaintDirty | Flag::PaintRepositioned);
+
+        if (!dirty) {
+          enqueuePaint(node);
+        }
       }
     }
   }
@@ -183,26 +305,218 @@ struct NodeImpl {
         narrow<std::intptr_t>(reinterpret_cast<std::uintptr_t>(from)));
   }
 
-  static constexpr Node::BloomFilter bloomFilterHash(TypeID id) noexcept {
-    constexpr std::size_t bits = sizeof(Node::BloomFilter) * 8;
+  static constexpr Node::ComponentMask componentMask(TypeID id) noexcept {
+    constexpr unsigned bits = sizeof(Node::ComponentMask) * 8 -
+                              dense_type_limit;
 
-    Node::BloomFilter mask = 0;
-    mask |= 1 << (id % bits);
-    mask |= 1 << ((id & 0xFF) ^ ((id >> 8) & 0xFF)) % bits;
+    if (id < dense_type_limit) {
+      return Node::ComponentMask(1) << id;
+    }
+
+    Node::ComponentMask mask = 0;
+    mask |= Node::ComponentMask(1) << (dense_type_limit + id % bits);
+    mask |= Node::ComponentMask(1)
+            << (dense_type_limit + ((id & 0xFF) ^ ((id >> 8) & 0xFF)) % bits);
 
     return mask;
   }
-  static constexpr bool bloomFilterContains(Node::BloomFilter filter,
-                                            TypeID id) noexcept {
-    return filter && (filter & bloomFilterHash(id));
+  static constexpr bool maskContains(Node::ComponentMask filter,
+                                     TypeID id) noexcept {
+    Node::ComponentMask const mask = componentMask(id);
+    return (filter & mask) == mask;
+  }
+
+  /// Returns the ComponentIndex of the Node if it has a usable one
+  static ComponentIndexBase* index(Node const& node) noexcept {
+    if (node.first_component_offset_) {
+      std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(&node) +
+                                 node.first_component_offset_;
+      Component* const first = reinterpret_cast<Component*>(pos);
+
+      if (first->type() == type_of<ComponentIndexBase>()) {
+        auto* const index = static_cast<ComponentIndexBase*>(first);
+        if (index->complete_) {
+          return index;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  /// Invokes the callback with every RegistryComponent whose subtree
+  /// contains the given Node
+  template <typename T>
+  static void registries(Node& node, T&& callback) {
+    constexpr TypeID type = type_of<RegistryComponent>();
+
+    for (Node* current = &node; current; current = current->parent_) {
+      if (current->contains(type)) {
+        for (Component& component : current->find(type)->siblings()) {
+          callback(static_cast<RegistryComponent&>(component));
+        }
+      }
+    }
+  }
+
+  /// Invalidates every LayerComponent whose subtree contains the Node
+  static void invalidateLayers(Node& current) noexcept {
+    constexpr TypeID type = type_of<LayerComponent>();
+
+    if (current.contains(type)) {
+      for (Component& component : current.find(type)->siblings()) {
+        static_cast<LayerComponent&>(component).invalidate();
+      }
+    }
+  }
+
+  /// Marks the SiblingOrder of the Container as outdated, which collects the
+  /// children again if its structure changed or resorts them otherwise
+  static void invalidateOrder(Node& container, bool structure) noexcept {
+    constexpr TypeID type = type_of<SiblingOrderBase>();
+
+    if (container.contains(type)) {
+      for (Component& component : container.find(type)->siblings()) {
+        auto& order = static_cast<SiblingOrderBase&>(component);
+        order.unsorted_ = true;
+        order.stale_ = order.stale_ || structure;
+      }
+    }
+  }
+
+  /// Marks the areas of every SpatialIndex and TraversalCache whose subtree
+  /// contains the Node as outdated
+  static void invalidateIndices(Node& node) noexcept {
+    constexpr TypeID spatial = type_of<SpatialIndex>();
+    constexpr TypeID traversal = type_of<TraversalCache>();
+
+    for (Node* current = &node; current; current = current->parent_) {
+      if (current->contains(spatial)) {
+        for (Component& component : current->find(spatial)->siblings()) {
+          static_cast<SpatialIndex&>(component).moved_ = true;
+        }
+      }
+
+      if (current->contains(traversal)) {
+        for (Component& component : current->find(traversal)->siblings()) {
+          static_cast<TraversalCache&>(component).moved_ = true;
+        }
+      }
+    }
+  }
+
+  /// Invalidates every TraversalCache, PaintWorklist, SpatialIndex and
+  /// LayerComponent whose subtree contains the given Node
+  static void invalidateStructure(Node& node) noexcept {
+    constexpr TypeID traversal = type_of<TraversalCache>();
+    constexpr TypeID worklist = type_of<PaintWorklistBase>();
+    constexpr TypeID spatial = type_of<SpatialIndex>();
+
+    for (Node* current = &node; current; current = current->parent_) {
+      invalidateLayers(*current);
+
+      if (current->contains(spatial)) {
+        for (Component& component : current->find(spatial)->siblings()) {
+          static_cast<SpatialIndex&>(component).stale_ = true;
+        }
+      }
+
+      if (current->contains(traversal)) {
+        for (Component& component : current->find(traversal)->siblings()) {
+          static_cast<TraversalCache&>(component).stale_ = true;
+        }
+      }
+
+      if (current->contains(worklist)) {
+        for (Component& component : current->find(worklist)->siblings()) {
+          static_cast<PaintWorklistBase&>(component).invalidate();
+        }
+      }
+    }
+  }
+
+  /// Invalidates the layers containing a Node that became paint dirty
+  /// and pushes it onto the worklist of its root
+  static void enqueuePaint(Node& node) noexcept {
+    constexpr TypeID type = type_of<PaintWorklistBase>();
+
+    Node* root = &node;
+    invalidateLayers(*root);
+
+    while (root->parent_) {
+      root = root->parent_;
+      invalidateLayers(*root);
+    }
+
+    if (root->contains(type)) {
+      for (Component& component : root->find(type)->siblings()) {
+        static_cast<PaintWorklistBase&>(component).push(node);
+      }
+    }
+  }
+
+  /// Records the shift of the displayed content of a scrolled Container
+  ///
+  /// The path to the Container is flagged separately from the paint dirty
+  /// state, such that scrolling doesn't count as a dirty child.
+  static void repaint_scrolled(Container& node, Vec2 offset) noexcept {
+    constexpr TypeID type = type_of<ScrollComponent>();
+
+    if (!node.contains(type)) {
+      node.repaint();
+      return;
+    }
+
+    static_cast<ScrollComponent*>(node.find(type))->pending_ += offset;
+
+    for (Node* current = &node; current; current = current->parent_) {
+      invalidateLayers(*current);
+      set(*current, Flag::PaintChildScrolled);
+    }
+  }
+
+  /// Links the child into the parent, subtree describes whether the Components
+  /// of the child need to be registered in the registries of the parent.
+  static Node::iterator insert(Container& parent, Node::iterator pos,
+                               Node& child, bool subtree) noexcept;
+
+  static void registerSubtree(Container& parent, Node& child) {
+    registries(parent, [&](RegistryComponent& registry) {
+      registry.attach(child);
+    });
+  }
+
+  static void deregisterSubtree(Container& parent, Node& child) {
+    registries(parent, [&](RegistryComponent& registry) {
+      registry.detach(child);
+    });
   }
 
   static void attachComponent(Component& component, Node& node) {
+    link(component, node);
+
+    TypeID const type = component.type();
+
+    if (type != type_of<ComponentIndexBase>()) {
+      if (ComponentIndexBase* const current = index(node)) {
+        current->insert(type, -component.owner_offset_);
+      }
+    }
+
+    if (type != type_of<RegistryComponent>()) {
+      registries(node, [&](RegistryComponent& registry) {
+        if (registry.registered() == type) {
+          registry.add(component);
+        }
+      });
+    }
+  }
+
+  static void link(Component& component, Node& node) {
     CUI_ASSERT(component.owner_offset_);
     Component::Offset const offset = -component.owner_offset_;
     TypeID const type = component.type();
 
-    node.components_filter_ |= bloomFilterHash(type);
+    node.components_filter_ |= componentMask(type);
 
     if (node.first_component_offset_) {
       auto [itr, end] = node.components();
@@ -237,8 +551,9 @@ struct NodeImpl {
 
         auto const current_type = itr->type();
         if (current_type > type) {
+          // Insert in between the previous and the current Component
           component.next_stranger_offset_ = std::exchange(
-              itr->next_stranger_offset_, offset);
+              previous.next_stranger_offset_, offset);
 
           return;
         }
@@ -320,7 +635,9 @@ Range<Component::sibling_const_iterator> Component::siblings() const noexcept {
 
 Node::Node(Container& parent, std::underlying_type_t<Flag> flags) noexcept
   : flags_(flags) {
-  parent.push_back(*this);
+  // A Node under construction has no Components or children that could be
+  // registered yet, its Components register themselves when attached.
+  NodeImpl::insert(parent, parent.end(), *this, false);
 }
 
 Node::Node(Node&& other) noexcept
@@ -368,8 +685,16 @@ Node::~Node() noexcept {
   detach();
 }
 
+bool Node::contains(TypeID type) const noexcept {
+  return NodeImpl::maskContains(components_filter_, type);
+}
+
 Component* Node::find(TypeID type) noexcept {
-  if (NodeImpl::bloomFilterContains(components_filter_, type)) {
+  if (NodeImpl::maskContains(components_filter_, type)) {
+    if (ComponentIndexBase const* const index = NodeImpl::index(*this)) {
+      return index->find(type);
+    }
+
     for (Component& component : components()) {
       if (component.type() == type) {
         return &component;
@@ -382,7 +707,11 @@ Component* Node::find(TypeID type) noexcept {
 }
 
 Component const* Node::find(TypeID type) const noexcept {
-  if (NodeImpl::bloomFilterContains(components_filter_, type)) {
+  if (NodeImpl::maskContains(components_filter_, type)) {
+    if (ComponentIndexBase const* const index = NodeImpl::index(*this)) {
+      return index->find(type);
+    }
+
     for (Component const& component : components()) {
       if (component.type() == type) {
         return &component;
@@ -428,9 +757,10 @@ void Node::detach() {
 
 bool Node::setArea(Rect const& area) noexcept {
   if (area_ != area) {
+    bool const resized = area_.size() != area.size();
     area_ = area;
 
-    NodeImpl::repaint_repositioned(*this);
+    NodeImpl::repaint_repositioned(*this, resized);
     return true;
   } else {
     return false;
@@ -441,7 +771,7 @@ bool Node::setPosition(Vec2 relative) noexcept {
   if (area_.low != relative) {
     area_.relocate(relative);
 
-    NodeImpl::repaint_repositioned(*this);
+    NodeImpl::repaint_repositioned(*this, false);
     return true;
   } else {
     return false;
@@ -452,7 +782,7 @@ bool Node::setSize(Vec2 size) noexcept {
   if (area_.size() != size) {
     area_.resize(size);
 
-    NodeImpl::repaint_repositioned(*this);
+    NodeImpl::repaint_repositioned(*this, true);
     return true;
   } else {
     return false;
@@ -486,6 +816,37 @@ void Node::reflow() noexcept {
   }
 }
 
+void Node::setRelayoutBoundary(bool boundary) noexcept {
+  if (isRelayoutBoundary() != boundary) {
+    if (boundary) {
+      NodeImpl::set(*this, Flag::RelayoutBoundary);
+    } else {
+      NodeImpl::unset(*this, Flag::RelayoutBoundary);
+    }
+
+    reflow();
+  }
+}
+
+void Node::setOpaque(bool opaque) noexcept {
+  if (isOpaque() != opaque) {
+    if (opaque) {
+      NodeImpl::set(*this, Flag::Opaque);
+
+      if (parent_) {
+        NodeImpl::set(*parent_, Flag::PaintChildOpaque);
+      }
+    } else {
+      NodeImpl::unset(*this, Flag::Opaque);
+
+      // The covered siblings were skipped and have to be painted again
+      if (parent_) {
+        NodeImpl::repaint_repositioned(*this, false);
+      }
+    }
+  }
+}
+
 bool Node::setConstraints(Constraints constraints) noexcept {
   if (constraints_ != constraints) {
     constraints_ = constraints;
@@ -529,15 +890,23 @@ Container& Container::operator=(Container&& other) noexcept {
 }
 
 Container::~Container() noexcept {
+  // Detach while this is still a Container, registries of the parent visit
+  // the erased subtree.
+  detach();
   clear();
 }
 
 Node::iterator Container::insert(iterator pos, Node& child) noexcept {
-  CUI_ASSERT(&child != this);
+  return NodeImpl::insert(*this, pos, child, true);
+}
+
+Node::iterator NodeImpl::insert(Container& parent, Node::iterator pos,
+                                Node& child, bool subtree) noexcept {
+  CUI_ASSERT(&child != &parent);
 
 #if !defined(NDEBUG) && defined(CUI_HAS_PEDANTIC_ASSERT)
   for (Node& current : parents(child)) {
-    CUI_ASSERT((current != *this) && "Node cycle detected!");
+    CUI_ASSERT((current != parent) && "Node cycle detected!");
   }
 #endif
 
@@ -545,54 +914,66 @@ Node::iterator Container::insert(iterator pos, Node& child) noexcept {
   CUI_ASSERT(!child.next_sibling_);
   CUI_ASSERT(!child.prev_sibling_);
 
-  clip_space_ = Rect::none();
+  parent.clip_space_ = Rect::none();
 
   for (MountComponent& component : each<MountComponent>(child)) {
-    component.onMount(*this);
+    component.onMount(parent);
   }
 
   // Get the iterator for the node left from the pos (right)
-  iterator left;
-  if (pos != end()) {
+  Node::iterator left;
+  if (pos != parent.end()) {
     left = prev(pos);
   } else {
-    left = iterator{last_child_};
+    left = Node::iterator{parent.last_child_};
   }
 
   // Previous
-  if (left != end()) {
+  if (left != parent.end()) {
     child.prev_sibling_ = &(*left);
     left->next_sibling_ = &child;
   } else {
-    first_child_ = &child;
+    parent.first_child_ = &child;
   }
 
   // Next
-  if (pos != end()) {
+  if (pos != parent.end()) {
     child.next_sibling_ = &(*pos);
     pos->prev_sibling_ = &child;
   } else {
-    last_child_ = &child;
+    parent.last_child_ = &child;
   }
 
-  child.parent_ = this;
+  child.parent_ = &parent;
 
-  CUI_ASSERT(first_child_);
-  CUI_ASSERT(last_child_);
-  CUI_ASSERT(child.parent() == this);
-  CUI_ASSERT(child.next_sibling_ || last_child_ == &child);
-  CUI_ASSERT(child.prev_sibling_ || first_child_ == &child);
+  CUI_ASSERT(parent.first_child_);
+  CUI_ASSERT(parent.last_child_);
+  CUI_ASSERT(child.parent() == &parent);
+  CUI_ASSERT(child.next_sibling_ || parent.last_child_ == &child);
+  CUI_ASSERT(child.prev_sibling_ || parent.first_child_ == &child);
   CUI_ASSERT(!child.next_sibling_ ||
              (child.prev_sibling_ != child.next_sibling_));
 
+  if (subtree) {
+    registerSubtree(parent, child);
+  }
+
+  invalidateStructure(parent);
+  invalidateOrder(parent, true);
+
+  if (child.isOpaque()) {
+    set(parent, Flag::PaintChildOpaque);
+  }
+
   child.constraints_ = Vec2::max();
   child.area_ = Rect::none();
+  unset(child, Flag::LayoutCulled);
 
-  reflow();
+  parent.reflow();
 
-  this->onChildAttached(child);
+  parent.onChildAttached(child);
 
-  return iterator{&child};
+  return Node::iterator{&child};
 }
 
 Node::iterator Container::erase(Node& child) {
@@ -606,6 +987,11 @@ Node::iterator Container::erase(Node& child) {
 
   reflow();
 
+  NodeImpl::deregisterSubtree(*this, child);
+  // Also invalidates the worklist of the child that becomes a root again
+  NodeImpl::invalidateStructure(child);
+  NodeImpl::invalidateOrder(*this, true);
+
   child.parent_ = nullptr;
 
   Node* const left = child.prev_sibling_;
@@ -674,8 +1060,14 @@ Vec2 Container::onLayoutEnd(Context& context) noexcept {
 }
 
 void Container::repaint() noexcept {
+  bool const dirty = isPaintDirty();
+
   NodeImpl::set(*this, PaintDirty);
   NodeImpl::flag_parent_child_paint_dirty(*this);
+
+  if (!dirty) {
+    NodeImpl::enqueuePaint(*this);
+  }
 }
 
 Vec2 Widget::preferredSize(Context& context) const noexcept {
@@ -683,10 +1075,62 @@ Vec2 Widget::preferredSize(Context& context) const noexcept {
   return Vec2::origin();
 }
 
+void Container::scroll(Vec2 offset) noexcept {
+  for (Node& child : children()) {
+    child.area_ += offset;
+  }
+
+  NodeImpl::invalidateIndices(*this);
+  NodeImpl::repaint_scrolled(*this, offset);
+}
+
+void Container::recycle(Node& child, Vec2 position) noexcept {
+  CUI_ASSERT(child.parent_ == this);
+
+  if (child.area_.low != position) {
+    child.area_.relocate(position);
+
+    NodeImpl::invalidateIndices(child);
+    NodeImpl::invalidateOrder(*this, false);
+  }
+
+  NodeAccess::repaint(child);
+}
+
+void Container::cull(Node& child, bool culled) noexcept {
+  CUI_ASSERT(child.parent_ == this);
+
+  if (culled) {
+    NodeImpl::set(child, LayoutCulled);
+  } else {
+    NodeImpl::unset(child, LayoutCulled);
+  }
+}
+
 void Widget::repaint() noexcept {
+  NodeImpl::unset(*this, PaintDamaged);
+
   if (!isPaintDirty()) {
     NodeImpl::set(*this, PaintDirty);
     NodeImpl::flag_parent_child_paint_dirty(*this);
+    NodeImpl::enqueuePaint(*this);
+  }
+}
+
+void Widget::repaint(Rect const& area) noexcept {
+  Rect const damage = Rect::ofIntersect(area, Rect::with(area_.size()));
+  if (!damage) {
+    return;
+  }
+
+  if (!isPaintDirty()) {
+    damage_ = damage;
+
+    NodeImpl::set(*this, PaintDirty | PaintDamaged);
+    NodeImpl::flag_parent_child_paint_dirty(*this);
+    NodeImpl::enqueuePaint(*this);
+  } else if (isPaintDamaged()) {
+    damage_ = Rect::ofUnion(damage_, damage);
   }
 }
 
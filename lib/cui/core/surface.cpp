@@ -32,4 +32,15 @@ void Surface::begin(Rect const& partial_window) noexcept {
 Rect Surface::split(Rect& area) const noexcept {
   return std::exchange(area, {});
 }
+
+bool Surface::scroll(Rect const& area, Vec2 offset) noexcept {
+  (void)area;
+  (void)offset;
+  return false;
+}
+
+Point Surface::glyphAdvance(char glyph) noexcept {
+  (void)glyph;
+  return 0;
+}
 } // namespace cui
@@ -87,6 +87,8 @@ constexpr auto node_details(Node const& node,
       if (container->isChildPaintDirtyDiverged()) {
         out << separator << "{:ChildPaintDirtyDiverged:}";
       }
+    } else if (cast<Widget>(*current).isPaintDamaged()) {
+      out << separator << "{:PaintDamaged:}";
     }
   });
 }
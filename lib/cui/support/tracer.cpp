@@ -149,4 +149,14 @@ Vec2 TracingSurface::stringBounds(std::string_view str) noexcept {
 
   return result;
 }
+
+Point TracingSurface::glyphAdvance(char glyph) noexcept {
+  fmt::print(*os_, FMT_STRING("Surface::glyphAdvance('{}')"), glyph);
+
+  auto const result = proxy_->glyphAdvance(glyph);
+
+  fmt::print(*os_, FMT_STRING(" -> {}\n"), result);
+
+  return result;
+}
 } // namespace cui
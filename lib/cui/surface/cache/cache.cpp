@@ -0,0 +1,441 @@
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <algorithm>
+#include <cstdint>
+#include <cui/core/paint.hpp>
+#include <cui/surface/cache/cache.hpp>
+#include <cui/util/assert.hpp>
+
+namespace cui {
+// FNV-1a
+static constexpr std::uint32_t hash_seed = 2166136261U;
+static constexpr std::uint32_t hash_prime = 16777619U;
+
+static std::uint32_t hash(std::uint32_t seed, void const* data,
+                          std::size_t size) noexcept {
+  auto const* bytes = static_cast<unsigned char const*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    seed = (seed ^ bytes[i]) * hash_prime;
+  }
+  return seed;
+}
+
+static constexpr std::uint32_t hash(std::uint32_t seed,
+                                    std::uint32_t value) noexcept {
+  return (seed ^ value) * hash_prime;
+}
+
+static constexpr std::uint32_t hash(std::uint32_t seed, Vec2 value) noexcept {
+  return hash(hash(seed, static_cast<std::uint16_t>(value.x)),
+              static_cast<std::uint16_t>(value.y));
+}
+
+static constexpr std::uint32_t hash(std::uint32_t seed,
+                                    Rect const& value) noexcept {
+  return hash(hash(seed, value.low), value.high);
+}
+
+static Paint paint_of(CachedSurface::Command const& command) noexcept {
+  return Paint(command.color, command.filled ? Paint::Flag_Filled : 0U);
+}
+
+/// Returns the count of payload bytes referenced by the command
+static std::size_t payload_of(CachedSurface::Command const& command) noexcept {
+  switch (command.kind) {
+    case CachedSurface::Command::Kind::Image:
+      return command.size * sizeof(std::uint16_t);
+    case CachedSurface::Command::Kind::BitImage:
+    case CachedSurface::Command::Kind::Text:
+      return command.size;
+    default:
+      return 0;
+  }
+}
+
+CachedSurface::CachedSurface(Surface& surface, Span<Command> commands,
+                             Span<std::uint8_t> payload,
+                             Span<std::uint32_t> hashes, Point tile) noexcept
+  : surface_(&surface)
+  , commands_(commands)
+  , payload_(payload)
+  , hashes_(hashes)
+  , tile_(tile) {
+  CUI_ASSERT(tile_ > 0);
+  CUI_ASSERT(tile_ % 8 == 0);
+
+  invalidate();
+}
+
+void CachedSurface::invalidate() noexcept {
+  std::fill(hashes_.data(), hashes_.data() + hashes_.size() / 2, 0U);
+}
+
+bool CachedSurface::changed() noexcept {
+  if (surface_->changed()) {
+    invalidate();
+    return true;
+  } else {
+    return false;
+  }
+}
+
+void CachedSurface::begin(Rect const& window) noexcept {
+  Vec2 const resolution = surface_->resolution();
+
+  window_ = window;
+  offset_ = Vec2::origin();
+  clip_space_ = Rect::all();
+  columns_ = tiles(resolution.x, tile_);
+  size_ = 0;
+  used_ = 0;
+
+  // Pass everything through if the tiles can't be stored
+  passthrough_ = hashes_.size() < capacity(resolution, tile_);
+  CUI_ASSERT(!passthrough_ && "Not enough tile capacity!");
+
+  if (passthrough_) {
+    surface_->begin(window);
+    return;
+  }
+
+  // Seed the tiles with the covered area, which makes partially covered tiles
+  // only comparable to tiles that were covered the same way.
+  Rect const indices = range(window_);
+  for (Point y = indices.low.y; y <= indices.high.y; ++y) {
+    for (Point x = indices.low.x; x <= indices.high.x; ++x) {
+      pending({x, y}) = hash(hash_seed, window_.clip(tile({x, y})));
+    }
+  }
+}
+
+void CachedSurface::end() noexcept {
+  Rect const indices = range(window_);
+
+  if (passthrough_) {
+    surface_->end();
+
+    if (hashes_.size() >= capacity(surface_->resolution(), tile_)) {
+      for (Point y = indices.low.y; y <= indices.high.y; ++y) {
+        for (Point x = indices.low.x; x <= indices.high.x; ++x) {
+          current({x, y}) = 0U;
+        }
+      }
+    }
+    return;
+  }
+
+  Rect changed;
+  for (Point y = indices.low.y; y <= indices.high.y; ++y) {
+    for (Point x = indices.low.x; x <= indices.high.x; ++x) {
+      // 0 is reserved for invalidated tiles
+      std::uint32_t const value = max(pending({x, y}), 1U);
+
+      if (current({x, y}) != value) {
+        current({x, y}) = value;
+
+        Rect const area = window_.clip(tile({x, y}));
+        changed = changed ? Rect::ofUnion(changed, area) : area;
+      }
+    }
+  }
+
+  while (changed) {
+    Rect const part = surface_->split(changed);
+
+    surface_->begin(part);
+    for (std::size_t i = 0; i < size_; ++i) {
+      replay(commands_[i]);
+    }
+    surface_->end();
+  }
+}
+
+void CachedSurface::flush() noexcept {
+  surface_->flush();
+}
+
+Vec2 CachedSurface::resolution() const noexcept {
+  return surface_->resolution();
+}
+
+void CachedSurface::view(Vec2 offset, Rect const& clip_space) noexcept {
+  Command command;
+  command.kind = Command::Kind::View;
+  command.position = offset;
+  command.area = clip_space;
+
+  offset_ = offset;
+  clip_space_ = clip_space;
+
+  record(command, Rect{});
+}
+
+Rect CachedSurface::split(Rect& area) const noexcept {
+  return surface_->split(area);
+}
+
+bool CachedSurface::scroll(Rect const& area, Vec2 offset) noexcept {
+  if (!surface_->scroll(area, offset)) {
+    return false;
+  }
+
+  Vec2 const resolution = surface_->resolution();
+  if (hashes_.size() < capacity(resolution, tile_)) {
+    return true;
+  }
+
+  // The tiles of the area don't describe the displayed content anymore
+  columns_ = tiles(resolution.x, tile_);
+
+  Rect const indices = range(area);
+  for (Point y = indices.low.y; y <= indices.high.y; ++y) {
+    for (Point x = indices.low.x; x <= indices.high.x; ++x) {
+      current({x, y}) = 0U;
+    }
+  }
+  return true;
+}
+
+void CachedSurface::drawPoint(Vec2 position, Paint const& paint) noexcept {
+  Command command;
+  command.kind = Command::Kind::Point;
+  command.color = paint.color();
+  command.filled = paint.isFilled();
+  command.position = position;
+
+  record(command, Rect{position, position} + offset_);
+}
+
+void CachedSurface::drawLine(Vec2 from, Vec2 to, Paint const& paint) noexcept {
+  Command command;
+  command.kind = Command::Kind::Line;
+  command.color = paint.color();
+  command.filled = paint.isFilled();
+  command.area = Rect{from, to};
+
+  record(command, Rect{min(from, to), max(from, to)} + offset_);
+}
+
+void CachedSurface::drawRect(Rect const& rect, Paint const& paint) noexcept {
+  Command command;
+  command.kind = Command::Kind::Rect;
+  command.color = paint.color();
+  command.filled = paint.isFilled();
+  command.area = rect;
+
+  record(command, rect + offset_);
+}
+
+void CachedSurface::drawCircle(Vec2 position, Point radius,
+                               Paint const& paint) noexcept {
+  Command command;
+  command.kind = Command::Kind::Circle;
+  command.color = paint.color();
+  command.filled = paint.isFilled();
+  command.position = position;
+  command.radius = radius;
+
+  record(command, Rect{position, position}.advance(radius) + offset_);
+}
+
+void CachedSurface::drawImage(Rect const& area,
+                              Span<std::uint16_t const> image) noexcept {
+  Command command;
+  command.kind = Command::Kind::Image;
+  command.area = area;
+  command.size = image.size();
+
+  record(command, area + offset_, image.data());
+}
+
+void CachedSurface::drawBitImage(Rect const& area,
+                                 Span<std::uint8_t const> image,
+                                 Paint const& imbue) noexcept {
+  Command command;
+  command.kind = Command::Kind::BitImage;
+  command.color = imbue.color();
+  command.filled = imbue.isFilled();
+  command.area = area;
+  command.size = image.size();
+
+  record(command, area + offset_, image.data());
+}
+
+void CachedSurface::drawText(Vec2 position, std::string_view str,
+                             Paint const& paint) noexcept {
+  Command command;
+  command.kind = Command::Kind::Text;
+  command.color = paint.color();
+  command.filled = paint.isFilled();
+  command.position = position;
+  command.size = str.size();
+
+  // The extent of the text is unknown, thus it could cover the whole view
+  record(command, clip_space_, str.data());
+}
+
+Vec2 CachedSurface::stringBounds(std::string_view str) noexcept {
+  return surface_->stringBounds(str);
+}
+
+Point CachedSurface::glyphAdvance(char glyph) noexcept {
+  return surface_->glyphAdvance(glyph);
+}
+
+void CachedSurface::record(Command command, Rect const& bounds,
+                           void const* data) noexcept {
+  if (passthrough_) {
+    replay(command, data);
+    return;
+  }
+
+  std::size_t const bytes = payload_of(command);
+
+  // Images are read as std::uint16_t values and need to be aligned
+  std::size_t offset = used_;
+  if (command.kind == Command::Kind::Image) {
+    offset += reinterpret_cast<std::uintptr_t>(payload_.data() + offset) %
+              alignof(std::uint16_t);
+  }
+
+  if ((size_ == commands_.size()) || (offset + bytes > payload_.size())) {
+    // The display list overflowed, continue without caching
+    passthrough_ = true;
+
+    surface_->begin(window_);
+    for (std::size_t i = 0; i < size_; ++i) {
+      replay(commands_[i]);
+    }
+    replay(command, data);
+    return;
+  }
+
+  if (bytes) {
+    std::copy_n(static_cast<std::uint8_t const*>(data), bytes,
+                payload_.data() + offset);
+
+    command.offset = offset;
+    used_ = offset + bytes;
+  }
+
+  commands_[size_++] = command;
+
+  if (command.kind == Command::Kind::View) {
+    return;
+  }
+
+  Rect const area = window_.clip(clip_space_.clip(bounds));
+  if (!area) {
+    return;
+  }
+
+  // Hash the command at its absolute position
+  std::uint32_t value = hash(hash_seed, static_cast<std::uint32_t>(
+                                            command.kind));
+  value = hash(value, static_cast<std::uint32_t>(command.filled));
+  value = hash(value, static_cast<std::uint16_t>(command.radius));
+  value = hash(value, std::uint32_t(command.color.r()) |
+                          (std::uint32_t(command.color.g()) << 8U) |
+                          (std::uint32_t(command.color.b()) << 16U) |
+                          (std::uint32_t(command.color.a()) << 24U));
+  value = hash(value, command.position + offset_);
+  value = hash(value, command.area + offset_);
+
+  value = hash(value, payload_.data() + command.offset, bytes);
+
+  Rect const indices = range(area);
+  for (Point y = indices.low.y; y <= indices.high.y; ++y) {
+    for (Point x = indices.low.x; x <= indices.high.x; ++x) {
+      std::uint32_t& current = pending({x, y});
+      current = hash(hash(current, value), area.clip(tile({x, y})));
+    }
+  }
+}
+
+void CachedSurface::replay(Command const& command) noexcept {
+  replay(command, payload_.data() + command.offset);
+}
+
+void CachedSurface::replay(Command const& command, void const* data) noexcept {
+  switch (command.kind) {
+    case Command::Kind::View:
+      surface_->view(command.position, command.area);
+      break;
+    case Command::Kind::Point:
+      surface_->drawPoint(command.position, paint_of(command));
+      break;
+    case Command::Kind::Line:
+      surface_->drawLine(command.area.low, command.area.high,
+                         paint_of(command));
+      break;
+    case Command::Kind::Rect:
+      surface_->drawRect(command.area, paint_of(command));
+      break;
+    case Command::Kind::Circle:
+      surface_->drawCircle(command.position, command.radius,
+                           paint_of(command));
+      break;
+    case Command::Kind::Image:
+      surface_->drawImage(
+          command.area,
+          {static_cast<std::uint16_t const*>(data), command.size});
+      break;
+    case Command::Kind::BitImage:
+      surface_->drawBitImage(
+          command.area,
+          {static_cast<std::uint8_t const*>(data), command.size},
+          paint_of(command));
+      break;
+    case Command::Kind::Text:
+      surface_->drawText(
+          command.position,
+          {static_cast<char const*>(data), command.size},
+          paint_of(command));
+      break;
+  }
+}
+
+Rect CachedSurface::range(Rect const& area) const noexcept {
+  CUI_ASSERT(area.low.x >= 0);
+  CUI_ASSERT(area.low.y >= 0);
+
+  return {{static_cast<Point>(area.low.x / tile_),
+           static_cast<Point>(area.low.y / tile_)},
+          {static_cast<Point>(area.high.x / tile_),
+           static_cast<Point>(area.high.y / tile_)}};
+}
+
+Rect CachedSurface::tile(Vec2 index) const noexcept {
+  return Rect::with({static_cast<Point>(index.x * tile_),
+                     static_cast<Point>(index.y * tile_)},
+                    {tile_, tile_});
+}
+
+std::uint32_t& CachedSurface::current(Vec2 index) noexcept {
+  return hashes_[columns_ * static_cast<std::size_t>(index.y) +
+                 static_cast<std::size_t>(index.x)];
+}
+
+std::uint32_t& CachedSurface::pending(Vec2 index) noexcept {
+  return hashes_[hashes_.size() / 2 +
+                 columns_ * static_cast<std::size_t>(index.y) +
+                 static_cast<std::size_t>(index.x)];
+}
+} // namespace cui
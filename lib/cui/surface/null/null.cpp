@@ -41,6 +41,11 @@ Rect NullSurface::split(Rect& area) const noexcept {
   return std::exchange(area, {});
 }
 
+bool NullSurface::scroll(Rect const&, Vec2) noexcept {
+  // There is no displayed content which could be shifted
+  return true;
+}
+
 void NullSurface::drawPoint(Vec2, Paint const&) noexcept {}
 
 void NullSurface::drawLine(Vec2, Vec2, Paint const&) noexcept {}
@@ -59,4 +64,9 @@ void NullSurface::drawText(Vec2, std::string_view, Paint const&) noexcept {}
 Vec2 NullSurface::stringBounds(std::string_view str) noexcept {
   return {narrow<Point>(str.size() * 5U), 8};
 }
+
+Point NullSurface::glyphAdvance(char glyph) noexcept {
+  (void)glyph;
+  return 5;
+}
 } // namespace cui
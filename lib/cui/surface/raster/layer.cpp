@@ -0,0 +1,61 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cui/core/algorithm.hpp>
+#include <cui/core/detail/pipeline_impl.hpp>
+#include <cui/core/node.hpp>
+#include <cui/core/surface.hpp>
+#include <cui/surface/raster/layer.hpp>
+#include <cui/surface/raster/raster.hpp>
+#include <cui/util/casting.hpp>
+
+namespace cui {
+RasterLayer::RasterLayer(Node& owner, Span<std::uint16_t> pixels) noexcept
+  : LayerComponent(owner)
+  , pixels_(pixels) {}
+
+bool RasterLayer::record(Surface& surface, Rect const& visible) noexcept {
+  if (WideRasterSurface::capacity(visible.size()) > pixels_.size()) {
+    return false;
+  }
+
+  // The offscreen surface renders the window directly into the pixels
+  WideRasterSurface::Sink sink;
+  WideRasterSurface offscreen(pixels_, sink, surface.resolution());
+
+  PositionRebuilder stack;
+  detail::push_parents(stack, owner());
+
+  offscreen.begin(visible);
+  for (Node& child : cast<Container>(owner()).children()) {
+    detail::paint_nodes<false>(child, offscreen, visible, stack);
+  }
+  offscreen.end();
+
+  return true;
+}
+
+void RasterLayer::draw(Surface& surface, Rect const& area,
+                       Rect const& clip) noexcept {
+  surface.view(Vec2::origin(), clip);
+  surface.drawImage(area,
+                    {pixels_.data(), WideRasterSurface::capacity(area.size())});
+}
+} // namespace cui
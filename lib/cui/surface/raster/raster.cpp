@@ -18,6 +18,7 @@
   along with this program. If not, see <https://www.gnu.org/licenses/>.
 **/
 
+#include <algorithm>
 #include <Adafruit_GFX.h>
 // #include <Fonts/FreeSansOblique18pt7b.h>
 #include <cui/core/draw.hpp>
@@ -103,6 +104,7 @@ void detail::GFXWrapper<T>::reset(Rect const& window,
   this->setTextWrap(false);
 
   clip_space_ = Rect::all();
+  touched_ = Rect::none();
 
   CUI_ASSERT(this->getBuffer() == data);
   CUI_ASSERT(this->width() == window.width());
@@ -174,16 +176,59 @@ void RasterSurface<GFXCanvas, Characteristics>::begin(
 template <typename GFXCanvas, typename Characteristics>
 void RasterSurface<GFXCanvas, Characteristics>::end() noexcept {
   // Flush the buffer content into the sink
-  Rect const area = rotate(rotation_, window_, resolution_);
+  Rect area = rotate(rotation_, window_, resolution_);
 
   CUI_ASSERT(area.low.x >= 0);
   CUI_ASSERT(area.low.y >= 0);
   CUI_ASSERT(area.high.x < resolution_.x);
   CUI_ASSERT(area.high.y < resolution_.y);
 
+  if (trimming_) {
+    Rect const touched = window_.clip(gfx_.touched() + window_.low);
+    if (!touched) {
+      // Nothing was drawn inside the window
+      return;
+    }
+
+    area = pack(area, rotate(rotation_, touched, resolution_));
+  }
+
   buffer_ = sink_->update(buffer_, area);
 }
 
+template <typename GFXCanvas, typename Characteristics>
+Rect RasterSurface<GFXCanvas, Characteristics>::pack(Rect const& area,
+                                                     Rect sub) noexcept {
+  constexpr Point density = Characteristics::density();
+
+  CUI_ASSERT(area.contains(sub));
+
+  // Widen the sub area horizontally to the buffer values it is encoded in
+  sub.low.x -= (sub.low.x - area.low.x) % density;
+  sub.high.x = min(narrow<Point>(sub.high.x + density - 1 -
+                                 ((sub.high.x - area.low.x) % density)),
+                   area.high.x);
+
+  if (sub == area) {
+    return area;
+  }
+
+  std::size_t const stride = Characteristics::capacity({area.width(), 1});
+  std::size_t const width = Characteristics::capacity({sub.width(), 1});
+  std::size_t const offset = narrow<std::size_t>((sub.low.x - area.low.x) /
+                                                 density);
+
+  // The packed rows never overlap a row that was not moved yet
+  value_type* out = buffer_.data();
+  for (Point y = sub.low.y; y <= sub.high.y; ++y) {
+    value_type const* const row = buffer_.data() + offset +
+                                  (y - area.low.y) * stride;
+    out = std::copy(row, row + width, out);
+  }
+
+  return sub;
+}
+
 template <typename GFXCanvas, typename Characteristics>
 void RasterSurface<GFXCanvas, Characteristics>::flush() noexcept {
   sink_->flush();
@@ -223,6 +268,22 @@ Vec2 RasterSurface<GFXCanvas, Characteristics>::stringBounds(
   return Rect{{min_x, min_y}, {max_x, max_y}}.size();
 }
 
+template <typename GFXCanvas, typename Characteristics>
+Point RasterSurface<GFXCanvas, Characteristics>::glyphAdvance(
+    char glyph) noexcept {
+  // charBounds advances the cursor the same way drawText does
+  std::int16_t x = 0;
+  std::int16_t y = 0;
+  std::int16_t min_x = std::numeric_limits<std::int16_t>::max();
+  std::int16_t min_y = min_x;
+  std::int16_t max_x = std::numeric_limits<std::int16_t>::min();
+  std::int16_t max_y = max_x;
+
+  gfx_.charBounds(glyph, &x, &y, &min_x, &min_y, &max_x, &max_y);
+
+  return x;
+}
+
 template <typename GFXCanvas, typename Characteristics>
 void RasterSurface<GFXCanvas, Characteristics>::view(
     Vec2 offset, Rect const& clip_space) noexcept {
@@ -280,6 +341,19 @@ void RasterSurface<GFXCanvas, Characteristics>::drawCircle(
   }
 }
 
+template <typename GFXCanvas, typename Characteristics>
+bool RasterSurface<GFXCanvas, Characteristics>::scroll(Rect const& area,
+                                                       Vec2 offset) noexcept {
+  CUI_ASSERT(Rect::with(resolution()).contains(area));
+
+  // The shift would need to be rotated into the native orientation as well
+  if (rotation_ != Rotation::Rotate_0) {
+    return false;
+  }
+
+  return sink_->scroll(area, offset);
+}
+
 template <typename GFXCanvas, typename Characteristics>
 void RasterSurface<GFXCanvas, Characteristics>::drawImage(
     Rect const& area, Span<std::uint16_t const> image) noexcept {
@@ -287,7 +361,9 @@ void RasterSurface<GFXCanvas, Characteristics>::drawImage(
   CUI_ASSERT((narrow<std::size_t>(area.width() * area.height())) <=
              image.size());
 
-  gfx_.drawRGBBitmap(area.low.x, area.high.y, image.data(), area.width(),
+  Rect const offset = area + translation_;
+
+  gfx_.drawRGBBitmap(offset.low.x, offset.low.y, image.data(), area.width(),
                      area.height());
 }
 
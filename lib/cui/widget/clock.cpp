@@ -41,9 +41,26 @@ void Clock::setGranularity(std::uint8_t granularity) noexcept {
 }
 
 void Clock::setTime(Duration time_point) noexcept {
+  Duration const previous = time_point_;
   time_point_ = Duration(time_point.count() % times::half_day);
 
-  repaint();
+  // The needles only move between two displayed steps
+  auto const step = resolution().count();
+  if (previous.count() / step == time_point_.count() / step) {
+    return;
+  }
+
+  repaint(Rect::ofUnion(needles(previous), needles(time_point_)));
+}
+
+Clock::Duration Clock::resolution() const noexcept {
+  if (granularity_ & Granularity::Seconds) {
+    return std::chrono::seconds(1);
+  } else if (granularity_ & Granularity::Minutes) {
+    return std::chrono::minutes(1);
+  } else {
+    return std::chrono::hours(1);
+  }
 }
 
 Vec2 Clock::preferredSize(Context& context) const noexcept {
@@ -53,61 +70,90 @@ Vec2 Clock::preferredSize(Context& context) const noexcept {
   return max(Vec2{m, m}, Vec2{8, 8});
 }
 
-static void drawNeedle(Canvas& canvas, Vec2 origin, Point length,
-                       float fraction, Paint const& paint) noexcept {
-
-  Vec2 const needle = rotate({0, static_cast<Point>(-max(length, 1))},
-                             fraction * 2 * pi);
-
-  canvas.drawLine(origin, origin + needle, paint);
-}
-
-void Clock::paint(Canvas& canvas) const noexcept {
-  Vec2 const half = {narrow<Point>(area().width() / 2),
-                     narrow<Point>(area().height() / 2)};
-  Vec2 const center = min(half - 1, area().size() - half - 1);
-
-  Point const radius = max(min(center.x, center.y), 1);
-
-  // Inner point
-  // canvas.drawPoint(center, inner);
-
-  if (!granularity_) {
-    return;
-  }
+/// Invokes the visitor with the paint, length and fraction of every needle
+/// which is displayed at the given time
+template <typename Visitor>
+static void visitNeedles(std::uint8_t granularity, Clock::Duration time,
+                         Point radius, Visitor&& visitor) noexcept {
+  auto const count = time.count();
 
-  auto const count = time_point_.count();
-
-  if (granularity_ & Granularity::Seconds) {
+  if (granularity & Clock::Granularity::Seconds) {
     constexpr Paint paint_seconds("#2481DE");
 
     auto const seconds = ((count % times::hour) % times::minute) /
                          times::second;
     CUI_ASSERT(seconds < 60);
 
-    drawNeedle(canvas, half, static_cast<Point>(radius * 5 / 6), seconds / 60.f,
-               paint_seconds);
+    visitor(paint_seconds, static_cast<Point>(radius * 5 / 6), seconds / 60.f);
   }
 
-  if (granularity_ & Granularity::Minutes) {
+  if (granularity & Clock::Granularity::Minutes) {
     constexpr Paint paint_minutes("#584AE8");
 
     auto const minutes = (count % times::hour) / times::minute;
     CUI_ASSERT(minutes < 60);
 
-    drawNeedle(canvas, half, static_cast<Point>(radius * 4 / 6), minutes / 60.f,
-               paint_minutes);
+    visitor(paint_minutes, static_cast<Point>(radius * 4 / 6), minutes / 60.f);
   }
 
-  if (granularity_ & Granularity::Hours) {
+  if (granularity & Clock::Granularity::Hours) {
     constexpr Paint paint_hours("#3A8EB2");
 
     auto const hours = count / times::hour;
     CUI_ASSERT(hours < 24);
 
-    drawNeedle(canvas, half, static_cast<Point>(radius * 4 / 6), hours / 12.f,
-               paint_hours);
+    visitor(paint_hours, static_cast<Point>(radius * 4 / 6), hours / 12.f);
   }
+}
+
+/// Returns the end of a needle relative to its origin
+static Vec2 needleOffset(Point length, float fraction) noexcept {
+  return rotate({0, static_cast<Point>(-max(length, 1))}, fraction * 2 * pi);
+}
+
+Vec2 Clock::origin() const noexcept {
+  return {narrow<Point>(area().width() / 2),
+          narrow<Point>(area().height() / 2)};
+}
+
+Point Clock::radius() const noexcept {
+  Vec2 const half = origin();
+  Vec2 const center = min(half - 1, area().size() - half - 1);
+
+  return max(min(center.x, center.y), 1);
+}
+
+Rect Clock::needles(Duration time) const noexcept {
+  Vec2 const half = origin();
+
+  Rect bounds = Rect::none();
+  visitNeedles(granularity_, time, radius(),
+               [&](Paint const&, Point length, float fraction) {
+                 Vec2 const end = half + needleOffset(length, fraction);
+                 Rect const needle{min(half, end), max(half, end)};
+                 bounds = bounds ? Rect::ofUnion(bounds, needle) : needle;
+               });
+  return bounds;
+}
+
+void Clock::paint(Canvas& canvas) const noexcept {
+  Vec2 const half = origin();
+  Vec2 const center = min(half - 1, area().size() - half - 1);
+
+  Point const radius = this->radius();
+
+  // Inner point
+  // canvas.drawPoint(center, inner);
+
+  if (!granularity_) {
+    return;
+  }
+
+  visitNeedles(granularity_, time_point_, radius,
+               [&](Paint const& paint, Point length, float fraction) {
+                 canvas.drawLine(half, half + needleOffset(length, fraction),
+                                 paint);
+               });
 
   canvas.drawCircle(center, radius);
 }
@@ -117,12 +163,12 @@ void AnimatedClock::setTime(Duration duration_since_midnight) noexcept {
 }
 
 Delta AnimatedClock::onUpdate(Delta diff) {
-  using namespace std::chrono_literals;
-
   auto const updated = clock_.time() + diff;
 
   clock_.setTime(updated);
 
-  return 1s;
+  // Wake up when the needles move next
+  auto const step = clock_.resolution();
+  return std::chrono::ceil<Delta>(step - (clock_.time() % step));
 }
 } // namespace cui
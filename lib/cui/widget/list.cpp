@@ -0,0 +1,153 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cui/core/math.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/widget/list.hpp>
+
+namespace cui {
+ListViewBase::ListViewBase(Container& parent, Point row,
+                           std::size_t size) noexcept
+  : Container(parent)
+  , row_(row)
+  , size_(size) {
+  CUI_ASSERT(row_ > 0);
+
+  setRelayoutBoundary();
+}
+
+void ListViewBase::setSize(std::size_t size) noexcept {
+  size_ = size;
+
+  // Keep the viewport inside of the remaining rows
+  std::size_t const end = size_ * static_cast<std::size_t>(row_);
+  std::size_t const height = static_cast<std::size_t>(area().height());
+  offset_ = min(offset_, (end > height) ? (end - height) : 0U);
+  first_ = offset_ / static_cast<std::size_t>(row_);
+
+  rebind();
+}
+
+void ListViewBase::scrollTo(std::size_t offset) noexcept {
+  std::size_t const end = size_ * static_cast<std::size_t>(row_);
+  std::size_t const height = static_cast<std::size_t>(area().height());
+  offset = min(offset, (end > height) ? (end - height) : 0U);
+
+  if (offset == offset_) {
+    return;
+  }
+
+  std::size_t const previous_first = first_;
+  std::size_t const previous_bound = bound();
+  std::size_t const previous_offset = offset_;
+
+  offset_ = offset;
+  first_ = offset_ / static_cast<std::size_t>(row_);
+
+  // Entries that stay inside the window keep their item
+  for (std::size_t i = first_, end = bound(); i < end; ++i) {
+    if ((i < previous_first) || (i >= previous_bound)) {
+      bind(i);
+    }
+  }
+
+  // The displayed rows can only be shifted if some of them stay visible and
+  // the items cover the viewport, such that every recycled item was scrolled
+  // out of view.
+  std::size_t const count = capacity();
+  std::size_t const distance = (offset_ > previous_offset)
+                                   ? (offset_ - previous_offset)
+                                   : (previous_offset - offset_);
+  if ((distance >= height) ||
+      (count * static_cast<std::size_t>(row_) <
+       height + static_cast<std::size_t>(row_))) {
+    place();
+    return;
+  }
+
+  scroll({0, static_cast<Point>(static_cast<std::ptrdiff_t>(previous_offset) -
+                               static_cast<std::ptrdiff_t>(offset_))});
+
+  for (std::size_t i = first_; i < first_ + count; ++i) {
+    Node& current = item(i);
+    Vec2 const target = position(i);
+
+    if (current.area().low != target) {
+      recycle(current, target);
+    }
+  }
+}
+
+void ListViewBase::scrollBy(std::ptrdiff_t distance) noexcept {
+  if ((distance < 0) && (static_cast<std::size_t>(-distance) > offset_)) {
+    scrollTo(0);
+  } else {
+    scrollTo(offset_ + static_cast<std::size_t>(distance));
+  }
+}
+
+void ListViewBase::rebind() noexcept {
+  for (std::size_t i = first_, end = bound(); i < end; ++i) {
+    bind(i);
+  }
+
+  place();
+}
+
+Constraints ListViewBase::onLayoutConstrain(Node& child) noexcept {
+  (void)child;
+  return {constraints().x, min(constraints().y, row_)};
+}
+
+Vec2 ListViewBase::onLayoutEnd(Context& context) noexcept {
+  (void)context;
+
+  CUI_ASSERT(constraints().x >= 0);
+  CUI_ASSERT(constraints().y >= 0);
+
+  place();
+  return constraints();
+}
+
+std::size_t ListViewBase::bound() const noexcept {
+  return min(first_ + capacity(), size_);
+}
+
+void ListViewBase::place() noexcept {
+  std::size_t const count = capacity();
+
+  for (std::size_t i = first_; i < first_ + count; ++i) {
+    item(i).setPosition(position(i));
+  }
+}
+
+Vec2 ListViewBase::position(std::size_t index) const noexcept {
+  if (index < bound()) {
+    // The distance to the viewport is small, even if the offset is not
+    Point const y = static_cast<Point>(
+        static_cast<std::ptrdiff_t>(index * static_cast<std::size_t>(row_)) -
+        static_cast<std::ptrdiff_t>(offset_));
+    return {0, y};
+  } else {
+    // Unused items are moved above the viewport, where they are culled
+    return {0, static_cast<Point>(-row_)};
+  }
+}
+} // namespace cui
@@ -0,0 +1,178 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstdint>
+#include <string_view>
+#include <cui/core/canvas.hpp>
+#include <cui/core/detail/offset.hpp>
+#include <cui/core/math.hpp>
+#include <cui/core/rect.hpp>
+#include <cui/core/vector.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/widget/paragraph.hpp>
+
+namespace cui {
+template <typename T>
+ParagraphBase<T>::ParagraphBase(Line* lines, std::size_t capacity, T text)
+  : text_(std::move(text))
+  , lines_offset_(detail::offset_between(this, lines))
+  , capacity_(static_cast<std::uint8_t>(capacity)) {}
+
+template <typename T>
+ParagraphBase<T>::ParagraphBase(Container& parent, Line* lines,
+                                std::size_t capacity, T text)
+  : Widget(parent)
+  , text_(std::move(text))
+  , lines_offset_(detail::offset_between(this, lines))
+  , capacity_(static_cast<std::uint8_t>(capacity)) {}
+
+template <typename T>
+void ParagraphBase<T>::setText(T text) {
+  text_ = std::move(text);
+
+  // The line breaks are measured again on the next layout
+  width_ = -1;
+
+  reflow();
+  repaint();
+}
+
+template <typename T>
+Range<typename ParagraphBase<T>::Line const*>
+ParagraphBase<T>::lines() const noexcept {
+  return {data(), data() + size_};
+}
+
+template <typename T>
+Vec2 ParagraphBase<T>::preferredSize(Context& context) const noexcept {
+  // A changed Surface relays out the Paragraph with the same width,
+  // thus the cached lines are keyed on its font as well
+  Point const space = context.glyphAdvance(' ');
+
+  if ((constraints().x != width_) || (space != space_)) {
+    space_ = space;
+    wrap(context, constraints().x);
+  }
+
+  Point widest = 0;
+  for (Line const& line : lines()) {
+    widest = max(widest, line.width);
+  }
+
+  return min(constraints(), Vec2{widest, narrow<Point>(size_ * line_height_)});
+}
+
+template <typename T>
+void ParagraphBase<T>::paint(Canvas& canvas) const noexcept {
+  std::string_view const text(text_);
+  Rect const region = canvas.region();
+
+  Point y = 0;
+  for (Line const& line : lines()) {
+    // Lines outside of the painted window are skipped
+    if ((y <= region.high.y) && (y + line_height_ > region.low.y)) {
+      canvas.drawText({0, y}, text.substr(line.offset, line.size));
+    }
+
+    y += line_height_;
+  }
+}
+
+template <typename T>
+void ParagraphBase<T>::wrap(Context& context, Point width) const noexcept {
+  std::string_view const text(text_);
+  CUI_ASSERT(text.size() <= 0xFFFF);
+
+  size_ = 0;
+  width_ = width;
+
+  // Every word is measured once, the width of a line is accumulated from its
+  // words and the advance of the spaces in between.
+  Vec2 const space = context.stringBounds(" ");
+  line_height_ = space.y;
+
+  // The word which did not fit into the previous line and its bounds
+  std::size_t carried = std::string_view::npos;
+  Vec2 carried_bounds;
+
+  std::size_t begin = 0;
+  while ((begin < text.size()) && (size_ < capacity_)) {
+    // The end of the words which fit into the line and their bounds
+    std::size_t end = begin;
+    Vec2 bounds;
+
+    for (std::size_t next = begin;;) {
+      std::size_t word = text.find_first_of(" \n", next);
+      if (word == std::string_view::npos) {
+        word = text.size();
+      }
+
+      Vec2 measured;
+      if (next == carried) {
+        measured = carried_bounds;
+      } else if (word != next) {
+        measured = context.stringBounds(text.substr(next, word - next));
+      }
+
+      Point const extent = (end == begin) ? measured.x
+                                          : bounds.x + space.x + measured.x;
+
+      // A word wider than the line is placed on a line of its own
+      if ((end != begin) && (extent > width)) {
+        carried = next;
+        carried_bounds = measured;
+        break;
+      }
+
+      end = word;
+      bounds = {extent, max(bounds.y, measured.y)};
+
+      if ((end == text.size()) || (text[end] == '\n')) {
+        break;
+      }
+      next = end + 1;
+    }
+
+    data()[size_++] = {narrow<std::uint16_t>(begin),
+                       narrow<std::uint16_t>(end - begin),
+                       max(bounds.x, Point(0))};
+    line_height_ = max(line_height_, bounds.y);
+
+    // Skip the separator and the spaces in front of the next line
+    begin = end;
+    if ((begin < text.size()) && (text[begin] == '\n')) {
+      ++begin;
+    }
+    while ((begin < text.size()) && (text[begin] == ' ')) {
+      ++begin;
+    }
+  }
+}
+
+template <typename T>
+typename ParagraphBase<T>::Line* ParagraphBase<T>::data() const noexcept {
+  std::uintptr_t const pos = reinterpret_cast<std::uintptr_t>(this) +
+                             lines_offset_;
+  return reinterpret_cast<Line*>(pos);
+}
+
+template class CUI_API_EXPORT ParagraphBase<std::string>;
+template class CUI_API_EXPORT ParagraphBase<std::string_view>;
+} // namespace cui
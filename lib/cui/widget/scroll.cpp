@@ -0,0 +1,117 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cui/core/math.hpp>
+#include <cui/util/assert.hpp>
+#include <cui/widget/scroll.hpp>
+
+namespace cui {
+void ScrollContainer::scrollTo(Vec2 offset) noexcept {
+  Vec2 const limited = limit(offset);
+
+  if (limited != offset_) {
+    Vec2 const distance = offset_ - limited;
+    offset_ = limited;
+
+    scroll(distance);
+
+    // Children that were culled while they were dirty are laid out now
+    if (cullHidden()) {
+      reflow();
+    }
+  }
+}
+
+void ScrollContainer::onLayoutBegin(Context& context) noexcept {
+  (void)context;
+
+  top_ = static_cast<Point>(-offset_.y);
+  previous_ = nullptr;
+}
+
+Constraints ScrollContainer::onLayoutConstrain(Node& child) noexcept {
+  // The previous child was laid out already, which places this child
+  // exactly unless the offset is limited further afterwards
+  if (previous_) {
+    top_ = static_cast<Point>(top_ + previous_->area().height());
+  }
+  previous_ = &child;
+
+  // Children which were never laid out have no size to be culled by
+  Point const height = child.area().height();
+  bool const hidden = (height > 0) && ((top_ + height <= 0) ||
+                                       (top_ >= constraints().y));
+
+  cull(child, hidden);
+  return hidden ? child.constraints() : constraints();
+}
+
+Vec2 ScrollContainer::onLayoutEnd(Context& context) noexcept {
+  (void)context;
+
+  CUI_ASSERT(constraints().x >= 0);
+  CUI_ASSERT(constraints().y >= 0);
+
+  // Culled children are stacked with the size of their last layout
+  extent_ = Vec2::origin();
+  for (Node& child : children()) {
+    Vec2 const size = child.area().size();
+
+    extent_.x = max(extent_.x, size.x);
+    extent_.y = static_cast<Point>(extent_.y + size.y);
+  }
+
+  offset_ = limit(offset_);
+
+  Point y = 0;
+  for (Node& child : children()) {
+    child.setPosition(Vec2{0, y} - offset_);
+    y = static_cast<Point>(y + child.area().height());
+  }
+
+  (void)cullHidden();
+
+  return constraints();
+}
+
+bool ScrollContainer::cullHidden() noexcept {
+  Rect const viewport = Rect::with(constraints());
+
+  bool pending = false;
+  for (Node& child : children()) {
+    Rect const& area = child.area();
+    bool const hidden = !area.empty() && !area.overlaps(viewport);
+
+    if (!hidden && child.isLayoutCulled() &&
+        (child.isLayoutDirty() || child.isChildLayoutDirty() ||
+         (child.constraints() != constraints()))) {
+      // Stays culled until the next layout of this Container constrains it
+      pending = true;
+    } else {
+      cull(child, hidden);
+    }
+  }
+  return pending;
+}
+
+Vec2 ScrollContainer::limit(Vec2 offset) const noexcept {
+  return max(min(offset, extent_ - constraints()), Vec2::origin());
+}
+} // namespace cui
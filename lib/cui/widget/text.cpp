@@ -18,30 +18,11 @@
   along with this program. If not, see <https://www.gnu.org/licenses/>.
 **/
 
-#include <cui/core/canvas.hpp>
-#include <cui/core/color.hpp>
-#include <cui/core/vector.hpp>
+#include <string>
+#include <string_view>
 #include <cui/widget/text.hpp>
 
 namespace cui {
-template <typename T>
-void TextBase<T>::setText(T text) {
-  text_ = std::move(text);
-
-  reflow();
-  repaint();
-}
-
-template <typename T>
-Vec2 TextBase<T>::preferredSize(Context& context) const noexcept {
-  return min(constraints(), context.stringBounds(text_));
-}
-
-template <typename T>
-void TextBase<T>::paint(Canvas& canvas) const noexcept {
-  canvas.drawText({0, 0}, text_);
-}
-
 template class CUI_API_EXPORT TextBase<std::string>;
 template class CUI_API_EXPORT TextBase<std::string_view>;
 } // namespace cui
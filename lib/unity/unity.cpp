@@ -22,12 +22,22 @@
 // required cui source files (core & widget) to build a user interface.
 
 #include "../cui/component/animation.cpp"
+#include "../cui/component/index.cpp"
 #include "../cui/component/input.cpp"
+#include "../cui/component/layer.cpp"
 #include "../cui/component/mount.cpp"
+#include "../cui/component/order.cpp"
 #include "../cui/component/ref.cpp"
+#include "../cui/component/registry.cpp"
+#include "../cui/component/scroll.cpp"
+#include "../cui/component/spatial.cpp"
+#include "../cui/component/traversal.cpp"
+#include "../cui/component/worklist.cpp"
 #include "../cui/core/algorithm.cpp"
+#include "../cui/core/arena.cpp"
 #include "../cui/core/canvas.cpp"
 #include "../cui/core/draw.cpp"
+#include "../cui/core/grid.cpp"
 #include "../cui/core/node.cpp"
 #include "../cui/core/paint.cpp"
 #include "../cui/core/surface.cpp"
@@ -38,5 +48,8 @@
 #include "../cui/widget/center.cpp"
 #include "../cui/widget/clock.cpp"
 #include "../cui/widget/fill.cpp"
+#include "../cui/widget/list.cpp"
 #include "../cui/widget/padding.cpp"
+#include "../cui/widget/paragraph.cpp"
+#include "../cui/widget/scroll.cpp"
 #include "../cui/widget/text.cpp"
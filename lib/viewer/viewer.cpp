@@ -737,6 +737,9 @@ void ViewerImpl::showToolTipImpl(Node& node) noexcept {
   if (node.isPaintRepositioned()) {
     ImGui::BulletText("PaintRepositioned");
   }
+  if (node.isOpaque()) {
+    ImGui::BulletText("Opaque");
+  }
 
   if (Container const* container = dyn_cast<Container>(node)) {
     if (container->isChildPaintDirty()) {
@@ -745,6 +748,8 @@ void ViewerImpl::showToolTipImpl(Node& node) noexcept {
     if (container->isChildPaintDirtyDiverged()) {
       ImGui::BulletText("ChildPaintDirtyDiverged");
     }
+  } else if (cast<Widget>(node).isPaintDamaged()) {
+    ImGui::BulletText("PaintDamaged");
   }
 
   if (NodeAccess::isGarbageCollected(node)) {
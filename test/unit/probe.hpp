@@ -0,0 +1,109 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <cui/cui.hpp>
+#include <cui/surface/raster.hpp>
+
+namespace cui::probe {
+/// A WideRasterSurface sink which keeps the display content and the windows
+/// that were passed to it
+struct FrameSink : WideRasterSurface::Sink {
+  explicit FrameSink(Vec2 resolution)
+    : size(resolution)
+    , frame(WideRasterSurface::capacity(resolution)) {}
+
+  Span<std::uint16_t> update(Span<std::uint16_t> buffer,
+                             Rect const& window) noexcept override {
+    std::uint16_t const* row = buffer.data();
+    for (Point y = window.low.y; y <= window.high.y; ++y) {
+      std::copy(row, row + window.width(), &at({window.low.x, y}));
+      row += window.width();
+    }
+
+    windows.push_back(window);
+    return buffer;
+  }
+
+  std::uint16_t& at(Vec2 position) noexcept {
+    return frame[position.y * size.x + position.x];
+  }
+  std::uint16_t at(Vec2 position) const noexcept {
+    return frame[position.y * size.x + position.x];
+  }
+
+  // The resolution of the display
+  Vec2 size;
+  std::vector<Rect> windows;
+  std::vector<std::uint16_t> frame;
+};
+
+/// Returns the display content of a full paint of the given tree
+inline std::vector<std::uint16_t> reference(Node& root, Vec2 resolution) {
+  FrameSink sink(resolution);
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  paint_full(root, surface, Rect::with(resolution));
+  return sink.frame;
+}
+
+/// A Widget that counts how often it was painted
+class PaintProbe : public Widget {
+public:
+  using Widget::Widget;
+
+  Vec2 preferredSize(Context& context) const noexcept override {
+    (void)context;
+    return {4, 4};
+  }
+
+  void change() noexcept {
+    repaint();
+  }
+
+  mutable int painted_{0};
+
+protected:
+  void paint(Canvas& canvas) const noexcept override {
+    ++painted_;
+    draw(canvas);
+  }
+
+  /// Draws the content of the probe
+  virtual void draw(Canvas& canvas) const noexcept {
+    (void)canvas;
+  }
+};
+
+/// A root Container which carries a PaintWorklist
+template <std::size_t Capacity, std::size_t Damage = 4>
+class WorklistScreen : public Container {
+public:
+  using Container::Container;
+
+  PaintWorklist<Capacity, Damage> worklist_{*this};
+};
+} // namespace cui::probe
@@ -0,0 +1,109 @@
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/cache.hpp>
+#include <cui/surface/raster.hpp>
+#include "probe.hpp"
+
+using namespace cui;
+
+namespace {
+constexpr Vec2 resolution{32, 32};
+
+/// Paints a label into the upper left tile and a box into the lower right one
+void paint(Surface& surface, int label, Color box) {
+  surface.begin(Rect::with(resolution));
+  surface.view(Vec2::origin(), Rect::with(resolution));
+
+  {
+    // The label is gone before the window is ended
+    std::string text = "n" + std::to_string(label);
+    surface.view(Vec2::origin(), Rect::with({16, 16}));
+    surface.drawText({1, 1}, text, Paint(Color::black()));
+    std::fill(text.begin(), text.end(), ' ');
+  }
+
+  surface.view(Vec2::origin(), Rect::with(resolution));
+  surface.drawRect(Rect::with({20, 20}, {8, 8}), Paint(box));
+  surface.end();
+  surface.flush();
+}
+} // namespace
+
+TEST_CASE("cached surfaces only rasterize changed tiles", "[surface]") {
+  probe::FrameSink sink(resolution);
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface raster(buffer, sink, resolution);
+
+  std::vector<CachedSurface::Command> commands(16);
+  std::vector<std::uint8_t> payload(64);
+  std::vector<std::uint32_t> hashes(CachedSurface::capacity(resolution));
+  CachedSurface surface(raster, commands, payload, hashes);
+
+  // Renders the same content without the cache
+  auto const expected = [&](int label, Color box) {
+    probe::FrameSink reference(resolution);
+    std::vector<std::uint16_t> storage(WideRasterSurface::capacity(resolution));
+    WideRasterSurface uncached(storage, reference, resolution);
+    paint(uncached, label, box);
+    return reference.frame;
+  };
+
+  paint(surface, 1, Color::black());
+  REQUIRE(sink.windows.size() == 1);
+  REQUIRE(sink.windows.back() == Rect::with(resolution));
+  REQUIRE(sink.frame == expected(1, Color::black()));
+  sink.windows.clear();
+
+  SECTION("unchanged tiles are not rasterized") {
+    paint(surface, 1, Color::black());
+    REQUIRE(sink.windows.empty());
+  }
+
+  SECTION("changed tiles are replayed") {
+    paint(surface, 1, Color::red());
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows.back() == Rect{{16, 16}, {31, 31}});
+    REQUIRE(sink.frame == expected(1, Color::red()));
+  }
+
+  SECTION("copied labels are replayed") {
+    paint(surface, 2, Color::black());
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows.back() == Rect{{0, 0}, {15, 15}});
+    REQUIRE(sink.frame == expected(2, Color::black()));
+  }
+
+  SECTION("overflowing payloads are passed through") {
+    std::vector<std::uint8_t> small(1);
+    CachedSurface overflowing(raster, commands, small, hashes);
+
+    sink.windows.clear();
+    paint(overflowing, 1, Color::black());
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows.back() == Rect::with(resolution));
+    REQUIRE(sink.frame == expected(1, Color::black()));
+  }
+}
@@ -0,0 +1,75 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <chrono>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+
+using namespace cui;
+using namespace std::chrono_literals;
+
+TEST_CASE("clocks only repaint the area of moved needles", "[widget]") {
+  Container screen;
+  Clock clock(screen);
+  clock.setTime(8h + 4min + 2s);
+
+  NullSurface surface;
+  layout(screen, surface);
+  clock.setArea(Rect::with({64, 64}));
+
+  paint_partial(screen, surface);
+  REQUIRE_FALSE(clock.isPaintDirty());
+
+  SECTION("a moved needle damages a part of the face") {
+    clock.setTime(8h + 4min + 3s);
+    REQUIRE(clock.isPaintDirty());
+    REQUIRE(clock.isPaintDamaged());
+
+    Rect const damage = clock.damage();
+    REQUIRE(Rect::with(clock.area().size()).contains(damage));
+    REQUIRE(damage.width() < clock.area().width() / 2);
+    REQUIRE(damage.contains(Vec2{32, 32}));
+  }
+
+  SECTION("unchanged needles are not repainted") {
+    clock.setTime(8h + 4min + 2s + 500ms);
+    REQUIRE_FALSE(clock.isPaintDirty());
+
+    clock.setGranularity(Clock::Minutes | Clock::Hours);
+    paint_partial(screen, surface);
+    REQUIRE(clock.resolution() == 1min);
+
+    clock.setTime(8h + 4min + 59s);
+    REQUIRE_FALSE(clock.isPaintDirty());
+
+    clock.setTime(8h + 5min);
+    REQUIRE(clock.isPaintDamaged());
+  }
+}
+
+TEST_CASE("animated clocks wake up when the needles move", "[widget]") {
+  Container screen;
+  AnimatedClock clock(screen);
+  clock.setTime(8h + 4min + 2s + 200ms);
+
+  REQUIRE(animate(screen, 0ms) == 800ms);
+  REQUIRE(animate(screen, 800ms) == 1s);
+}
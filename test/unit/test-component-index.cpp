@@ -0,0 +1,121 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+
+using namespace cui;
+
+template <std::size_t I>
+class TaggedComponent : public Component {
+public:
+  explicit TaggedComponent(Node& owner)
+    : Component(type_of(this), owner) {}
+};
+
+struct NoIndex {
+  explicit NoIndex(Node&) noexcept {}
+};
+
+template <typename Sequence, std::size_t Capacity, bool Indexed>
+class ComponentWidget;
+template <std::size_t... I, std::size_t Capacity, bool Indexed>
+class ComponentWidget<std::index_sequence<I...>, Capacity, Indexed>
+  : public Widget {
+public:
+  using Widget::Widget;
+
+  template <std::size_t J>
+  TaggedComponent<J>& get() noexcept {
+    return std::get<J>(components_);
+  }
+
+  template <std::size_t J>
+  bool finds() noexcept {
+    return any<TaggedComponent<J>>(*this) == &get<J>();
+  }
+
+  bool findsAll() noexcept {
+    return (finds<I>() && ...);
+  }
+
+  std::conditional_t<Indexed, ComponentIndex<Capacity>, NoIndex> index_{*this};
+  std::tuple<TaggedComponent<I>...> components_{
+      (static_cast<void>(I), static_cast<Node&>(*this))...};
+};
+
+template <std::size_t N, bool Indexed = true, std::size_t Capacity = N>
+using TestWidget = ComponentWidget<std::make_index_sequence<N>, Capacity,
+                                   Indexed>;
+
+TEST_CASE("component indices find all components", "[component]") {
+  TestWidget<8> widget;
+
+  REQUIRE(widget.index_.size() == 8);
+  REQUIRE(widget.index_.complete());
+  REQUIRE(widget.findsAll());
+  REQUIRE(any<ComponentIndexBase>(widget) == &widget.index_);
+
+  SECTION("after being moved") {
+    auto relocated = std::move(widget);
+    REQUIRE(relocated.findsAll());
+  }
+
+  SECTION("including components attached later") {
+    TaggedComponent<3> another(widget);
+    REQUIRE(widget.index_.size() == 8);
+    REQUIRE(widget.finds<3>());
+    REQUIRE(std::distance(each<TaggedComponent<3>>(widget).begin(),
+                          each<TaggedComponent<3>>(widget).end()) == 2);
+  }
+
+  SECTION("on overflow") {
+    TestWidget<8, true, 4> overflowed;
+    REQUIRE_FALSE(overflowed.index_.complete());
+    REQUIRE(overflowed.findsAll());
+  }
+}
+
+#ifdef CATCH_CONFIG_ENABLE_BENCHMARKING
+template <std::size_t N, bool Indexed>
+static void benchmark_find(char const* name) {
+  TestWidget<N, Indexed> widget;
+
+  BENCHMARK(name) {
+    return widget.findsAll();
+  };
+}
+
+TEST_CASE("component lookup throughput", "[!benchmark]") {
+  benchmark_find<1, false>("find 1 component");
+  benchmark_find<1, true>("find 1 indexed component");
+  benchmark_find<4, false>("find 4 components");
+  benchmark_find<4, true>("find 4 indexed components");
+  benchmark_find<8, false>("find 8 components");
+  benchmark_find<8, true>("find 8 indexed components");
+  benchmark_find<16, false>("find 16 components");
+  benchmark_find<16, true>("find 16 indexed components");
+  benchmark_find<32, false>("find 32 components");
+  benchmark_find<32, true>("find 32 indexed components");
+}
+#endif
@@ -0,0 +1,120 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+
+using namespace cui;
+
+class TelemetryComponent : public Component {
+public:
+  explicit TelemetryComponent(Node& owner)
+    : Component(type_of(this), owner) {}
+};
+
+class TelemetryWidget : public Widget {
+public:
+  using Widget::Widget;
+
+  TelemetryComponent telemetry_{*this};
+};
+
+template <std::size_t Capacity>
+class TelemetryScreen : public Container {
+public:
+  using Container::Container;
+
+  std::vector<TelemetryComponent*> registered() {
+    std::vector<TelemetryComponent*> result;
+    for (TelemetryComponent& component : registry_) {
+      result.push_back(&component);
+    }
+    return result;
+  }
+
+  std::vector<TelemetryComponent*> visited() {
+    std::vector<TelemetryComponent*> result;
+    visit_components<TelemetryComponent>(
+        *this, [&](TelemetryComponent& component) {
+          result.push_back(&component);
+        });
+    return result;
+  }
+
+  ComponentRegistry<TelemetryComponent, Capacity> registry_{*this};
+};
+
+using Registered = std::vector<TelemetryComponent*>;
+
+TEST_CASE("component registries track their subtree", "[component]") {
+  TelemetryScreen<4> screen;
+  Container group(screen);
+  TelemetryWidget first(group);
+  TelemetryWidget second;
+
+  REQUIRE(screen.registered() == Registered{&first.telemetry_});
+
+  SECTION("on insertion and erasure") {
+    screen.push_back(second);
+    REQUIRE(screen.registered() ==
+            Registered{&first.telemetry_, &second.telemetry_});
+
+    screen.erase(group);
+    REQUIRE(screen.registered() == Registered{&second.telemetry_});
+  }
+
+  SECTION("on attached components") {
+    TelemetryComponent late(group);
+    REQUIRE(screen.registered() == Registered{&first.telemetry_, &late});
+  }
+
+  SECTION("on moved nodes") {
+    TelemetryWidget moved(std::move(first));
+    REQUIRE(screen.registered() == Registered{&moved.telemetry_});
+  }
+
+  SECTION("with the default capacity") {
+    class DefaultScreen : public Container {
+    public:
+      ComponentRegistry<TelemetryComponent> registry_{*this};
+    } other;
+
+    screen.erase(group);
+    other.push_back(group);
+
+    Registered registered;
+    for (TelemetryComponent& component : other.registry_) {
+      registered.push_back(&component);
+    }
+    REQUIRE(registered == Registered{&first.telemetry_});
+  }
+
+  SECTION("on overflow") {
+    TelemetryScreen<1> small;
+    TelemetryWidget a(small);
+    TelemetryWidget b(small);
+
+    REQUIRE_FALSE(small.registry_.complete());
+    REQUIRE(small.visited() == Registered{&a.telemetry_, &b.telemetry_});
+  }
+}
@@ -73,3 +73,18 @@ TEST_CASE("test component behaviour", "[component]") {
   // We are moving by value only
   REQUIRE(wdgt.components()); // NO-LINT
 }
+
+TEST_CASE("dense component types are tracked exactly", "[component]") {
+  STATIC_REQUIRE(type_of<MountComponent>() < dense_type_limit);
+  STATIC_REQUIRE(type_of<TestComponent>() >= dense_type_limit);
+
+  TestWidget wdgt;
+  REQUIRE(wdgt.contains(type_of<TestComponent>()));
+  REQUIRE_FALSE(wdgt.contains(type_of<MountComponent>()));
+  REQUIRE_FALSE(wdgt.contains(type_of<AnimationComponent>()));
+
+  MountComponent mount(wdgt);
+  REQUIRE(wdgt.contains(type_of<MountComponent>()));
+  REQUIRE(any<MountComponent>(wdgt) == &mount);
+  REQUIRE_FALSE(wdgt.contains(type_of<AnimationComponent>()));
+}
@@ -0,0 +1,253 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <initializer_list>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/raster.hpp>
+
+using namespace cui;
+
+namespace {
+template <typename SurfaceType>
+struct RecordingSink : SurfaceType::Sink {
+  using value_type = typename SurfaceType::value_type;
+
+  Span<value_type> update(Span<value_type> buffer,
+                          Rect const& window) noexcept override {
+    windows.push_back(window);
+    return buffer;
+  }
+
+  std::vector<Rect> windows;
+};
+
+/// Hands out a second buffer after every update like a double buffered sink,
+/// the returned buffer is scrambled to detect reads from it.
+template <typename SurfaceType>
+struct SwappingSink : SurfaceType::Sink {
+  using value_type = typename SurfaceType::value_type;
+
+  explicit SwappingSink(std::size_t capacity)
+    : front(capacity)
+    , back(capacity) {}
+
+  Span<value_type> update(Span<value_type> buffer,
+                          Rect const& window) noexcept override {
+    std::size_t const size = SurfaceType::capacity(window.size());
+    windows.push_back(window);
+    contents.emplace_back(buffer.data(), buffer.data() + size);
+
+    std::swap(front, back);
+    std::fill(front.begin(), front.end(), value_type(0x1234));
+    return front;
+  }
+
+  std::vector<value_type> front;
+  std::vector<value_type> back;
+  std::vector<Rect> windows;
+  std::vector<std::vector<value_type>> contents;
+};
+
+/// Keeps every passed buffer like a sink which transfers it in the background
+/// and hands out a fresh buffer for the next update
+template <typename SurfaceType>
+struct RetainingSink : SurfaceType::Sink {
+  using value_type = typename SurfaceType::value_type;
+
+  explicit RetainingSink(std::size_t capacity)
+    : pool(4, std::vector<value_type>(capacity)) {}
+
+  Span<value_type> update(Span<value_type> buffer,
+                          Rect const& window) noexcept override {
+    buffers.push_back(buffer.data());
+    windows.push_back(window);
+
+    next = (next + 1) % pool.size();
+    std::fill(pool[next].begin(), pool[next].end(), value_type(0x1234));
+    return pool[next];
+  }
+
+  std::vector<std::vector<value_type>> pool;
+  std::size_t next{0};
+  std::vector<value_type const*> buffers;
+  std::vector<Rect> windows;
+};
+} // namespace
+
+TEST_CASE("diff sinks only forward changed regions", "[surface]") {
+  using SurfaceType = WideRasterSurface;
+  constexpr Vec2 resolution{32, 32};
+
+  RecordingSink<SurfaceType> sink;
+  std::vector<SurfaceType::value_type> shadow(
+      SurfaceType::capacity(resolution));
+  std::vector<SurfaceType::value_type> buffer(
+      SurfaceType::capacity(resolution));
+
+  DiffSink<SurfaceType> diff(sink, shadow, resolution, 2);
+  SurfaceType surface(buffer, diff, resolution);
+
+  auto const paint = [&](std::initializer_list<Vec2> points) {
+    surface.begin(Rect::with(resolution));
+    surface.view(Vec2::origin(), Rect::all());
+    surface.drawRect(Rect::with({4, 4}, {4, 4}), Paint(Color::black()));
+    for (Vec2 point : points) {
+      surface.drawPoint(point, Paint(Color::black()));
+    }
+    surface.end();
+    surface.flush();
+  };
+
+  // The first update is always forwarded
+  paint({});
+  REQUIRE(sink.windows.size() == 1);
+  REQUIRE(sink.windows.back() == Rect::with(resolution));
+  sink.windows.clear();
+
+  SECTION("unchanged windows are dropped") {
+    paint({});
+    REQUIRE(sink.windows.empty());
+  }
+
+  SECTION("changed windows are shrunk") {
+    paint({{16, 8}, {18, 9}});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows.back() == Rect{{16, 8}, {18, 9}});
+
+    sink.windows.clear();
+    paint({});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows.back() == Rect{{16, 8}, {18, 9}});
+  }
+
+  SECTION("distant changes are forwarded separately") {
+    paint({{30, 0}, {10, 20}, {12, 22}});
+    REQUIRE(sink.windows.size() == 2);
+    REQUIRE(sink.windows[0] == Rect{{30, 0}, {30, 0}});
+    REQUIRE(sink.windows[1] == Rect{{10, 20}, {12, 22}});
+  }
+
+  SECTION("invalidated shadows forward everything") {
+    diff.invalidate();
+    paint({});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows.back() == Rect::with(resolution));
+  }
+}
+
+TEST_CASE("diff sinks keep comparing the incoming buffer", "[surface]") {
+  using SurfaceType = WideRasterSurface;
+  using value_type = SurfaceType::value_type;
+  constexpr Vec2 resolution{32, 32};
+
+  SwappingSink<SurfaceType> sink(SurfaceType::capacity(resolution));
+  std::vector<value_type> shadow(SurfaceType::capacity(resolution));
+  std::vector<value_type> buffer(SurfaceType::capacity(resolution));
+
+  DiffSink<SurfaceType> diff(sink, shadow, resolution, 2);
+  SurfaceType surface(buffer, diff, resolution);
+
+  auto const paint = [&](std::initializer_list<Vec2> points) {
+    surface.begin(Rect::with(resolution));
+    surface.view(Vec2::origin(), Rect::all());
+    for (Vec2 point : points) {
+      surface.drawPoint(point, Paint(Color::black()));
+    }
+    surface.end();
+    surface.flush();
+  };
+
+  paint({});
+  sink.windows.clear();
+  sink.contents.clear();
+
+  paint({{30, 0}, {10, 20}, {12, 22}});
+  REQUIRE(sink.windows.size() == 2);
+  REQUIRE(sink.windows[0] == Rect{{30, 0}, {30, 0}});
+  REQUIRE(sink.windows[1] == Rect{{10, 20}, {12, 22}});
+
+  value_type const black = SurfaceType::encode(Color::black());
+  value_type const white = SurfaceType::encode(Color::white());
+
+  REQUIRE(sink.contents[0] == std::vector<value_type>{black});
+  REQUIRE(sink.contents[1] == std::vector<value_type>{black, white, white, //
+                                                      white, white, white, //
+                                                      white, white, black});
+
+  // The shadow was updated from the painted frame, not the swapped buffer
+  sink.windows.clear();
+  paint({{30, 0}, {10, 20}, {12, 22}});
+  REQUIRE(sink.windows.empty());
+}
+
+TEST_CASE("diff sinks pack bands into the buffer returned by the sink",
+          "[surface]") {
+  using SurfaceType = WideRasterSurface;
+  using value_type = SurfaceType::value_type;
+  constexpr Vec2 resolution{32, 32};
+
+  RetainingSink<SurfaceType> sink(SurfaceType::capacity(resolution));
+  std::vector<value_type> shadow(SurfaceType::capacity(resolution));
+  std::vector<value_type> buffer(SurfaceType::capacity(resolution));
+
+  DiffSink<SurfaceType> diff(sink, shadow, resolution, 2);
+  SurfaceType surface(buffer, diff, resolution);
+
+  auto const paint = [&](std::initializer_list<Vec2> points) {
+    surface.begin(Rect::with(resolution));
+    surface.view(Vec2::origin(), Rect::all());
+    surface.drawRect(Rect::with(resolution), Paint(Color::white()));
+    for (Vec2 point : points) {
+      surface.drawPoint(point, Paint(Color::black()));
+    }
+    surface.end();
+    surface.flush();
+  };
+
+  paint({});
+  sink.buffers.clear();
+  sink.windows.clear();
+
+  paint({{4, 2}, {6, 2}, {10, 12}, {10, 13}, {8, 24}});
+  REQUIRE(sink.windows.size() == 3);
+  REQUIRE(sink.windows[0] == Rect{{4, 2}, {6, 2}});
+  REQUIRE(sink.windows[1] == Rect{{10, 12}, {10, 13}});
+  REQUIRE(sink.windows[2] == Rect{{8, 24}, {8, 24}});
+
+  // Every band got its own buffer, which still holds the band after the
+  // following bands were forwarded
+  REQUIRE(sink.buffers[0] != sink.buffers[1]);
+  REQUIRE(sink.buffers[1] != sink.buffers[2]);
+  REQUIRE(sink.buffers[0] != sink.buffers[2]);
+
+  value_type const black = SurfaceType::encode(Color::black());
+  value_type const white = SurfaceType::encode(Color::white());
+
+  auto const content = [&](std::size_t i) {
+    std::size_t const size = SurfaceType::capacity(sink.windows[i].size());
+    return std::vector<value_type>(sink.buffers[i], sink.buffers[i] + size);
+  };
+
+  REQUIRE(content(0) == std::vector<value_type>{black, white, black});
+  REQUIRE(content(1) == std::vector<value_type>{black, black});
+  REQUIRE(content(2) == std::vector<value_type>{black});
+}
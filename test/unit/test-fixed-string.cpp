@@ -0,0 +1,82 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <string_view>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/external/fmt.hpp>
+#include <cui/surface/null.hpp>
+#include <cui/util/fixed_string.hpp>
+
+using namespace cui;
+
+TEST_CASE("fixed strings store their content inline", "[util]") {
+  constexpr FixedString<8> label("12:00");
+  static_assert(label.size() == 5);
+  static_assert(label == std::string_view("12:00"));
+
+  SECTION("exceeding content is clipped") {
+    FixedString<4> str;
+    REQUIRE_FALSE(str.assign("123456"));
+    REQUIRE(str == "1234");
+    REQUIRE(std::string_view(str.c_str()) == "1234");
+
+    REQUIRE(str.assign("12"));
+    REQUIRE_FALSE(str.append("345"));
+    REQUIRE(str == "1234");
+  }
+
+  SECTION("exceeding content is ended with an ellipsis") {
+    FixedString<6> str("Temperature", Truncation::Ellipsis);
+    REQUIRE(str == "Tem...");
+  }
+
+  SECTION("arguments are formatted into the buffer") {
+    FixedString<8> str;
+    REQUIRE(format_into(str, Truncation::Clip, "{}:{:02}", 12, 5));
+    REQUIRE(str == "12:05");
+
+    REQUIRE_FALSE(format_into(str, Truncation::Ellipsis, "{} rpm", 123456));
+    REQUIRE(str == "12345...");
+  }
+}
+
+TEST_CASE("static texts display fixed strings", "[widget]") {
+  Container screen;
+  StaticText<8> label(screen, "12:00");
+
+  NullSurface surface;
+  layout(screen, surface);
+  paint_partial(screen, surface);
+  REQUIRE(label.area().size() == Vec2{25, 8});
+
+  FixedString<8> str;
+  REQUIRE(format_into(str, Truncation::Clip, "{}:{:02}", 12, 7));
+  label.setText(str);
+  REQUIRE(label.text() == "12:07");
+
+  layout(screen, surface);
+  REQUIRE(label.isPaintDamaged());
+  REQUIRE(label.damage() == Rect{{20, 0}, {24, 7}});
+
+  label.setText("1:07");
+  REQUIRE(label.isLayoutDirty());
+  REQUIRE_FALSE(label.isPaintDamaged());
+}
@@ -18,9 +18,11 @@
   along with this program. If not, see <https://www.gnu.org/licenses/>.
 **/
 
+#include <type_traits>
 #include <variant>
 #include <catch2/catch.hpp>
 #include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
 
 using namespace cui;
 
@@ -81,3 +83,47 @@ TEST_CASE("test hook behaviour", "[functional]") {
     REQUIRE(component3(MyInputEvent::Two) == MAGIC_VALUE2);
   }
 }
+
+class StaticPaintWidget final : public Widget {
+public:
+  using Widget::Widget;
+
+  int dynamic{0};
+  int statically{0};
+
+protected:
+  void paint(Canvas& canvas) const noexcept override {
+    draw(canvas);
+  }
+
+private:
+  template <typename C>
+  void draw(C& canvas) const noexcept {
+    if constexpr (std::is_same_v<C, BasicCanvas<NullSurface>>) {
+      ++const_cast<StaticPaintWidget*>(this)->statically;
+    } else {
+      ++const_cast<StaticPaintWidget*>(this)->dynamic;
+    }
+
+    canvas.drawPoint({0, 0});
+  }
+
+  PaintComponent<NullSurface> paint_{
+      *this, bind<&StaticPaintWidget::draw<BasicCanvas<NullSurface>>>()};
+};
+
+TEST_CASE("paint hooks are dispatched statically", "[functional]") {
+  StaticPaintWidget widget;
+  widget.setArea(Rect::with({10, 10}));
+
+  NullSurface surface;
+  paint_full(widget, surface);
+
+  REQUIRE(widget.statically == 1);
+  REQUIRE(widget.dynamic == 0);
+
+  paint_full(widget, static_cast<Surface&>(surface));
+
+  REQUIRE(widget.statically == 1);
+  REQUIRE(widget.dynamic == 1);
+}
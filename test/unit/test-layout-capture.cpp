@@ -0,0 +1,88 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+
+using namespace cui;
+
+static auto make_tree() {
+  return Align(Alignment{AlignOrientation::Vertical}, Padding(Text("first")),
+               Center(Text("second")), Text("third"));
+}
+
+TEST_CASE("captured layouts can be adopted", "[pipeline]") {
+  auto source = make_tree();
+  NullSurface source_surface;
+  layout(*source, source_surface);
+
+  LayoutRecord records[16];
+  std::size_t const size = capture_layout(*source, records);
+  REQUIRE(size == 6);
+
+  auto tree = make_tree();
+  NullSurface surface;
+
+  SECTION("matching records are adopted") {
+    REQUIRE(adopt_layout(*tree, surface, {records, size}));
+
+    std::vector<Rect> areas;
+    for (Accept& current : traverse(*tree)) {
+      if (current.isPre()) {
+        REQUIRE_FALSE(current->isLayoutDirty());
+        REQUIRE_FALSE(current->isChildLayoutDirty());
+
+        areas.push_back(current->area());
+      }
+    }
+
+    LayoutRecord adopted[16];
+    REQUIRE(capture_layout(*tree, adopted) == size);
+    for (std::size_t i = 0; i < size; ++i) {
+      REQUIRE(adopted[i].area == records[i].area);
+      REQUIRE(adopted[i].constraints == records[i].constraints);
+    }
+
+    // The following layout has nothing to do
+    layout(*tree, surface);
+    LayoutRecord relayouted[16];
+    REQUIRE(capture_layout(*tree, relayouted) == size);
+    for (std::size_t i = 0; i < size; ++i) {
+      REQUIRE(relayouted[i].area == areas[i]);
+    }
+  }
+
+  SECTION("mismatching records are rejected") {
+    REQUIRE_FALSE(adopt_layout(*tree, surface, {records, size - 1}));
+    REQUIRE(tree->isLayoutDirty());
+  }
+
+  SECTION("records of differently shaped trees are rejected") {
+    auto other = Align(Alignment{AlignOrientation::Vertical},
+                       Padding(Text("first")), Text("second"),
+                       Center(Text("third")));
+
+    REQUIRE(capture_layout(*other, {}) == size);
+    REQUIRE_FALSE(adopt_layout(*other, surface, {records, size}));
+    REQUIRE(other->isLayoutDirty());
+  }
+}
@@ -0,0 +1,164 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+#include <cui/surface/raster.hpp>
+
+using namespace cui;
+
+namespace {
+class EntryProbe : public Widget {
+public:
+  using Widget::Widget;
+
+  Vec2 preferredSize(Context& context) const noexcept override {
+    (void)context;
+    return {32, 4};
+  }
+
+  std::size_t index_{0};
+};
+
+class ListScreen : public Container {
+public:
+  void bindEntry(EntryProbe& item, std::size_t index) noexcept {
+    item.index_ = index;
+    ++bound_;
+  }
+
+  std::size_t bound_{0};
+  ListView<EntryProbe, 9> list_{*this, 4, 10000,
+                                bind<&ListScreen::bindEntry>()};
+};
+
+/// Returns true if every visible row shows the entry at its position
+bool placed(ListScreen& screen) {
+  for (Node& current : screen.list_.children()) {
+    auto const& item = static_cast<EntryProbe const&>(current);
+    Rect const area = current.area();
+
+    if (area.low.y < 0) {
+      continue;
+    }
+
+    std::size_t const y = item.index_ * 4 - screen.list_.offset();
+    if (static_cast<std::size_t>(area.low.y) != y) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("list views recycle a fixed pool of items", "[widget]") {
+  ListScreen screen;
+  NullSurface surface;
+  layout(screen, surface);
+
+  std::size_t nodes = 0;
+  for (Node& current : visit(screen)) {
+    (void)current;
+    ++nodes;
+  }
+
+  // The screen, the list and its recycled items only
+  REQUIRE(nodes == 11);
+  REQUIRE(screen.bound_ == 9);
+  REQUIRE(screen.list_.area().size() == surface.resolution());
+  REQUIRE(placed(screen));
+
+  SECTION("scrolling binds the entered entries only") {
+    screen.bound_ = 0;
+    screen.list_.scrollBy(6);
+    REQUIRE(screen.list_.first() == 1);
+    REQUIRE(screen.bound_ == 1);
+    REQUIRE(placed(screen));
+
+    screen.list_.scrollBy(-6);
+    REQUIRE(screen.list_.first() == 0);
+    REQUIRE(screen.bound_ == 2);
+    REQUIRE(placed(screen));
+  }
+
+  SECTION("the viewport stays inside of the rows") {
+    screen.list_.scrollTo(100000);
+    REQUIRE(screen.list_.offset() ==
+            10000 * 4 - static_cast<std::size_t>(surface.resolution().y));
+    REQUIRE(placed(screen));
+
+    screen.list_.scrollBy(-100000);
+    REQUIRE(screen.list_.offset() == 0);
+  }
+
+  SECTION("unused items are culled") {
+    screen.list_.scrollTo(100);
+    screen.list_.setSize(3);
+    REQUIRE(screen.list_.offset() == 0);
+    REQUIRE(placed(screen));
+
+    std::size_t culled = 0;
+    for (Node& current : screen.list_.children()) {
+      if (current.area().low.y < 0) {
+        ++culled;
+      }
+    }
+    REQUIRE(culled == 6);
+  }
+}
+
+TEST_CASE("list views shift their rows when scrolled", "[widget]") {
+  constexpr Vec2 resolution{32, 32};
+
+  WideRasterSurface::Sink sink;
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  ListScreen screen;
+  layout(screen, surface);
+  paint_partial(screen, surface);
+
+  screen.list_.scrollBy(6);
+  REQUIRE_FALSE(screen.list_.isPaintDirty());
+  REQUIRE(screen.list_.isChildScrolled());
+  REQUIRE(placed(screen));
+
+  // Only the item of the entered entry is painted again
+  std::size_t dirty = 0;
+  for (Node& current : screen.list_.children()) {
+    dirty += current.isPaintDirty() ? 1 : 0;
+  }
+  REQUIRE(dirty == 1);
+
+  paint_partial(screen, surface);
+  for (Node& current : visit(screen)) {
+    REQUIRE_FALSE(current.isPaintDirty());
+  }
+
+  SECTION("far jumps place every item again") {
+    screen.list_.scrollTo(400);
+    REQUIRE(screen.list_.isPaintDirty());
+    REQUIRE(placed(screen));
+  }
+}
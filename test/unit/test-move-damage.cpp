@@ -0,0 +1,100 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <iterator>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+#include "probe.hpp"
+
+using namespace cui;
+
+using probe::PaintProbe;
+
+TEST_CASE("moved nodes repaint their old and new areas", "[pipeline]") {
+  probe::WorklistScreen<8, 1> screen;
+  Container dashboard(screen);
+  PaintProbe badge(dashboard);
+  PaintProbe below(dashboard);
+  PaintProbe far(dashboard);
+
+  NullSurface surface;
+  layout(screen, surface);
+
+  dashboard.setArea(Rect::with({512, 512}));
+  below.setArea(Rect::with({8, 8}, {32, 32}));
+  badge.setArea(Rect::with({16, 16}, {8, 8}));
+  far.setArea(Rect::with({400, 400}, {32, 32}));
+
+  paint_partial(screen, surface);
+  REQUIRE(screen.worklist_.complete());
+  REQUIRE(badge.painted_ == 1);
+  REQUIRE(below.painted_ == 1);
+  REQUIRE(far.painted_ == 1);
+
+  SECTION("the parent stays clean") {
+    badge.setPosition({200, 16});
+    badge.setPosition({208, 16});
+
+    REQUIRE_FALSE(dashboard.isPaintDirty());
+    REQUIRE(badge.isPaintDirty());
+    REQUIRE(std::distance(screen.worklist_.damage().begin(),
+                          screen.worklist_.damage().end()) == 1);
+    REQUIRE(*screen.worklist_.damage().begin() ==
+            Rect::with({16, 16}, {8, 8}));
+
+    paint_partial(screen, surface);
+
+    // The vacated area is painted from the root, the badge at its new area
+    REQUIRE(below.painted_ == 2);
+    REQUIRE(badge.painted_ == 2);
+    REQUIRE(far.painted_ == 1);
+    REQUIRE_FALSE(screen.worklist_.damage());
+    REQUIRE(badge.clipSpace() == Rect::with({208, 16}, {8, 8}));
+
+    for (Node& current : visit(screen)) {
+      REQUIRE_FALSE(current.isPaintDirty());
+    }
+  }
+
+  SECTION("overlapping damage is merged") {
+    badge.setSize({12, 12});
+    below.setSize({40, 40});
+
+    REQUIRE_FALSE(dashboard.isPaintDirty());
+    REQUIRE(std::distance(screen.worklist_.damage().begin(),
+                          screen.worklist_.damage().end()) == 1);
+    REQUIRE(*screen.worklist_.damage().begin() ==
+            Rect::with({8, 8}, {32, 32}));
+  }
+
+  SECTION("exceeding the damage repaints the parent") {
+    badge.setPosition({200, 16});
+    far.setPosition({300, 300});
+
+    REQUIRE(dashboard.isPaintDirty());
+
+    paint_partial(screen, surface);
+    // The recorded damage is painted in addition to the dirty parent
+    REQUIRE(below.painted_ == 3);
+    REQUIRE(badge.painted_ == 2);
+    REQUIRE(far.painted_ == 2);
+  }
+}
@@ -0,0 +1,135 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <utility>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+
+using namespace cui;
+
+TEST_CASE("node arenas mirror the tree", "[arena]") {
+  auto tree = Align(Alignment{AlignOrientation::Vertical},
+                    Padding(Text("first")), Center(Text("second")),
+                    Text("third"));
+  NullSurface surface;
+  layout(*tree, surface);
+
+  BasicNodeArena<16> arena;
+  REQUIRE(arena.assign(*tree));
+  REQUIRE(arena.size() == 6);
+
+  arena.refresh();
+
+  NodeArena::Index index = 0;
+  for (Node& current : visit(*tree)) {
+    REQUIRE(&arena.node(index) == &current);
+    REQUIRE(arena.clip(index) == absolute(current).clip);
+    REQUIRE(arena.clip(index) == current.clipSpace());
+
+    NodeArena::Index const parent = arena.parent(index);
+    if (parent == NodeArena::npos) {
+      REQUIRE(index == 0);
+    } else {
+      REQUIRE(&arena.node(parent) == current.parent());
+      REQUIRE(arena.end(index) <= arena.end(parent));
+    }
+    ++index;
+  }
+  REQUIRE(arena.end(0) == arena.size());
+
+  SECTION("intersections match the tree") {
+    for (NodeArena::Index i = 0; i < arena.size(); ++i) {
+      Vec2 const position = arena.clip(i).low;
+      NodeArena::Index const found = arena.intersection(position);
+
+      REQUIRE(found != NodeArena::npos);
+      REQUIRE(&arena.node(found) == intersection(*tree, position));
+    }
+
+    REQUIRE(arena.intersection(Vec2{-1, -1}) == NodeArena::npos);
+  }
+
+  SECTION("exceeding the capacity empties the arena") {
+    BasicNodeArena<4> small;
+    REQUIRE_FALSE(small.assign(*tree));
+    REQUIRE(small.empty());
+  }
+}
+
+class CachedScreen : public Container {
+public:
+  using Container::Container;
+
+  BasicNodeArena<8> arena_;
+  TraversalCache cache_{*this, arena_};
+};
+
+TEST_CASE("traversal caches follow the tree", "[arena]") {
+  CachedScreen screen;
+  Container group(screen);
+  Text first(group);
+  Text second;
+  first.setText("first");
+  second.setText("second");
+
+  REQUIRE(screen.cache_.isStale());
+  REQUIRE(screen.cache_.arena()->size() == 3);
+  REQUIRE_FALSE(screen.cache_.isStale());
+
+  NullSurface surface;
+  layout(screen, surface);
+  paint_partial(screen, surface);
+
+  for (Node& current : visit(screen)) {
+    REQUIRE_FALSE(current.isPaintDirty());
+    REQUIRE(current.clipSpace() == absolute(current).clip);
+  }
+
+  SECTION("on insertion and erasure") {
+    screen.push_back(second);
+    REQUIRE(screen.cache_.isStale());
+    REQUIRE(screen.cache_.arena()->size() == 4);
+
+    group.erase(first);
+    REQUIRE(screen.cache_.isStale());
+    REQUIRE(screen.cache_.arena()->size() == 3);
+  }
+
+  SECTION("on repositioned nodes") {
+    // Unchanged areas are not recomputed on every paint
+    NodeAccess::setClipSpace(first, Rect::none());
+    paint_full(screen, surface);
+    REQUIRE(first.clipSpace() == Rect::none());
+
+    first.setPosition({4, 4});
+    REQUIRE(screen.cache_.isStale());
+
+    paint_full(screen, surface);
+    REQUIRE_FALSE(screen.cache_.isStale());
+    REQUIRE(first.clipSpace() == absolute(first).clip);
+  }
+
+  SECTION("on moved nodes") {
+    Text moved(std::move(first));
+    REQUIRE(screen.cache_.isStale());
+    REQUIRE(&screen.cache_.arena()->node(2) == &moved);
+  }
+}
@@ -0,0 +1,176 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+#include "probe.hpp"
+
+using namespace cui;
+
+using probe::PaintProbe;
+
+namespace {
+class CachedScreen : public Container {
+public:
+  using Container::Container;
+
+  BasicNodeArena<8> arena_;
+  TraversalCache cache_{*this, arena_};
+};
+} // namespace
+
+TEST_CASE("opaque siblings occlude the nodes below them", "[pipeline]") {
+  Container screen;
+  Container dashboard(screen);
+  PaintProbe covered(dashboard);
+  PaintProbe exposed(dashboard);
+  PaintProbe modal(screen);
+  modal.setOpaque();
+
+  NullSurface surface;
+  layout(screen, surface);
+
+  dashboard.setArea(Rect::with({256, 256}));
+  covered.setArea(Rect::with({8, 8}, {16, 16}));
+  exposed.setArea(Rect::with({200, 8}, {16, 16}));
+  modal.setArea(Rect::with({4, 4}, {64, 64}));
+
+  REQUIRE(screen.isChildOpaque());
+  REQUIRE_FALSE(dashboard.isChildOpaque());
+
+  paint_partial(screen, surface);
+  REQUIRE(covered.painted_ == 0);
+  REQUIRE(exposed.painted_ == 1);
+  REQUIRE(modal.painted_ == 1);
+
+  SECTION("covered dirty nodes are skipped") {
+    covered.change();
+    exposed.change();
+
+    paint_partial(screen, surface);
+    REQUIRE(covered.painted_ == 0);
+    REQUIRE(exposed.painted_ == 2);
+    REQUIRE(modal.painted_ == 1);
+
+    for (Node& current : visit(screen)) {
+      REQUIRE_FALSE(current.isPaintDirty());
+    }
+  }
+
+  SECTION("full paints skip covered nodes") {
+    paint_full(screen, surface);
+    REQUIRE(covered.painted_ == 0);
+    REQUIRE(exposed.painted_ == 2);
+    REQUIRE(modal.painted_ == 2);
+  }
+
+  SECTION("uncovered nodes are painted again") {
+    modal.setOpaque(false);
+
+    paint_partial(screen, surface);
+    REQUIRE(covered.painted_ == 1);
+    REQUIRE(exposed.painted_ == 2);
+    REQUIRE(modal.painted_ == 2);
+  }
+
+  SECTION("partially covered nodes are painted") {
+    covered.setArea(Rect::with({60, 60}, {16, 16}));
+
+    paint_partial(screen, surface);
+    REQUIRE(covered.painted_ == 1);
+  }
+}
+
+TEMPLATE_TEST_CASE("only later opaque siblings occlude nodes", "[pipeline]",
+                   Container, CachedScreen) {
+  TestType screen;
+  PaintProbe first(screen);
+  PaintProbe above(screen);
+  PaintProbe below(screen);
+  PaintProbe second(screen);
+  first.setOpaque();
+  second.setOpaque();
+
+  NullSurface surface;
+  layout(screen, surface);
+
+  first.setArea(Rect::with({0, 0}, {32, 32}));
+  above.setArea(Rect::with({8, 8}, {8, 8}));
+  below.setArea(Rect::with({72, 8}, {8, 8}));
+  second.setArea(Rect::with({64, 0}, {32, 32}));
+
+  paint_full(screen, surface);
+  REQUIRE(first.painted_ == 1);
+  REQUIRE(above.painted_ == 1);
+  REQUIRE(below.painted_ == 0);
+  REQUIRE(second.painted_ == 1);
+
+  above.change();
+  below.change();
+
+  paint_partial(screen, surface);
+  REQUIRE(above.painted_ == 2);
+  REQUIRE(below.painted_ == 0);
+}
+
+TEST_CASE("static paints skip occluded nodes", "[pipeline]") {
+  Inplace tree(type_identity<Container>{}, inplace,
+               Inplace(type_identity<Container>{}, inplace, PaintProbe(),
+                       PaintProbe()),
+               PaintProbe());
+  auto& [dashboard, modal] = tree.elements();
+  auto& [covered, exposed] = dashboard.elements();
+  modal.setOpaque();
+
+  NullSurface surface;
+  static_layout(tree, surface);
+
+  dashboard->setArea(Rect::with({256, 256}));
+  covered.setArea(Rect::with({8, 8}, {16, 16}));
+  exposed.setArea(Rect::with({200, 8}, {16, 16}));
+  modal.setArea(Rect::with({4, 4}, {64, 64}));
+
+  static_paint_partial(tree, surface);
+  REQUIRE(covered.painted_ == 0);
+  REQUIRE(exposed.painted_ == 1);
+  REQUIRE(modal.painted_ == 1);
+
+  SECTION("covered dirty nodes are skipped") {
+    covered.change();
+    exposed.change();
+
+    static_paint_partial(tree, surface);
+    REQUIRE(covered.painted_ == 0);
+    REQUIRE(exposed.painted_ == 2);
+    REQUIRE(modal.painted_ == 1);
+
+    for (Node& current : visit(*tree)) {
+      REQUIRE_FALSE(current.isPaintDirty());
+    }
+  }
+
+  SECTION("full paints skip covered nodes") {
+    static_paint_full(tree, surface);
+    REQUIRE(covered.painted_ == 0);
+    REQUIRE(exposed.painted_ == 2);
+    REQUIRE(modal.painted_ == 2);
+  }
+}
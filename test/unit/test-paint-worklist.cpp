@@ -0,0 +1,106 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+#include "probe.hpp"
+
+using namespace cui;
+using probe::PaintProbe;
+
+TEST_CASE("paint worklists repaint listed nodes only", "[pipeline]") {
+  probe::WorklistScreen<2> screen;
+  PaintProbe first(screen);
+  PaintProbe second(screen);
+  PaintProbe third(screen);
+
+  NullSurface surface;
+  layout(screen, surface);
+
+  // The first paint traverses the tree
+  REQUIRE_FALSE(screen.worklist_.complete());
+  paint_partial(screen, surface);
+  REQUIRE(screen.worklist_.complete());
+  REQUIRE(first.painted_ == 1);
+  REQUIRE(second.painted_ == 1);
+  REQUIRE(third.painted_ == 1);
+
+  SECTION("listed nodes are painted") {
+    second.change();
+    second.change();
+    REQUIRE(screen.worklist_.size() == 1);
+
+    paint_partial(screen, surface);
+    REQUIRE(first.painted_ == 1);
+    REQUIRE(second.painted_ == 2);
+    REQUIRE(third.painted_ == 1);
+
+    for (Node& current : visit(screen)) {
+      REQUIRE_FALSE(current.isPaintDirty());
+    }
+    REQUIRE_FALSE(screen.isChildPaintDirty());
+    REQUIRE(screen.worklist_.size() == 0);
+  }
+
+  SECTION("overflowed worklists fall back to a traversal") {
+    first.change();
+    second.change();
+    third.change();
+    REQUIRE_FALSE(screen.worklist_.complete());
+
+    paint_partial(screen, surface);
+    REQUIRE(first.painted_ == 2);
+    REQUIRE(second.painted_ == 2);
+    REQUIRE(third.painted_ == 2);
+    REQUIRE(screen.worklist_.complete());
+  }
+
+  SECTION("structural changes invalidate the worklist") {
+    screen.erase(third);
+    REQUIRE_FALSE(screen.worklist_.complete());
+  }
+}
+
+TEST_CASE("static partial paints use the worklist", "[pipeline]") {
+  Inplace tree(type_identity<probe::WorklistScreen<2>>{}, inplace,
+               PaintProbe(), PaintProbe(), PaintProbe());
+  auto& [first, second, third] = tree.elements();
+
+  NullSurface surface;
+  static_layout(tree, surface);
+
+  static_paint_partial(tree, surface);
+  REQUIRE(tree->worklist_.complete());
+  REQUIRE(second.painted_ == 1);
+
+  // The worklist is consumed on every frame and never overflows
+  for (int frame = 0; frame < 4; ++frame) {
+    second.change();
+
+    static_paint_partial(tree, surface);
+    REQUIRE(tree->worklist_.complete());
+    REQUIRE(tree->worklist_.size() == 0);
+  }
+
+  REQUIRE(first.painted_ == 1);
+  REQUIRE(second.painted_ == 5);
+  REQUIRE(third.painted_ == 1);
+}
@@ -0,0 +1,167 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/support/tracer.hpp>
+#include <cui/surface/null.hpp>
+
+using namespace cui;
+
+namespace {
+/// Returns the count of occurrences of the given call in the trace
+std::size_t calls(std::ostringstream& trace, std::string_view call) {
+  std::string const str = std::exchange(trace, {}).str();
+
+  std::size_t count = 0;
+  for (std::size_t pos = str.find(call); pos != std::string::npos;
+       pos = str.find(call, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+/// Measures text with a monospaced font which is scaled by a factor
+class ScaledSurface final : public Surface {
+public:
+  explicit ScaledSurface(Point scale) noexcept
+    : scale_(scale) {}
+
+  Vec2 resolution() const noexcept override {
+    return {512, 512};
+  }
+
+  void view(Vec2 offset, Rect const& clip_space) noexcept override {
+    (void)offset;
+    (void)clip_space;
+  }
+
+  void drawPoint(Vec2, Paint const&) noexcept override {}
+  void drawLine(Vec2, Vec2, Paint const&) noexcept override {}
+  void drawRect(Rect const&, Paint const&) noexcept override {}
+  void drawCircle(Vec2, Point, Paint const&) noexcept override {}
+  void drawImage(Rect const&, Span<std::uint16_t const>) noexcept override {}
+  void drawBitImage(Rect const&, Span<std::uint8_t const>,
+                    Paint const&) noexcept override {}
+  void drawText(Vec2, std::string_view, Paint const&) noexcept override {}
+
+  Vec2 stringBounds(std::string_view str) noexcept override {
+    return {static_cast<Point>(str.size() * 5 * scale_),
+            static_cast<Point>(8 * scale_)};
+  }
+
+  Point glyphAdvance(char glyph) noexcept override {
+    (void)glyph;
+    return static_cast<Point>(5 * scale_);
+  }
+
+private:
+  Point scale_;
+};
+
+template <typename T>
+std::vector<std::string> wrapped(ParagraphBase<T> const& paragraph) {
+  std::string_view const text(paragraph.text());
+
+  std::vector<std::string> result;
+  for (auto const& line : paragraph.lines()) {
+    result.emplace_back(text.substr(line.offset, line.size));
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("paragraphs wrap their text at word boundaries", "[widget]") {
+  NullSurface null;
+  std::ostringstream trace;
+  TracingSurface surface(null, trace, false);
+  Context context(surface);
+
+  Paragraph<4> paragraph("The quick brown fox jumps");
+  paragraph.setConstraints({50, 100});
+
+  REQUIRE(paragraph.preferredSize(context) == Vec2{45, 24});
+  REQUIRE(wrapped(paragraph) ==
+          std::vector<std::string>{"The quick", "brown fox", "jumps"});
+
+  // Every word and the separating space are measured once
+  REQUIRE(calls(trace, "stringBounds") == 6);
+
+  SECTION("the line breaks are cached for the width") {
+    REQUIRE(paragraph.preferredSize(context) == Vec2{45, 24});
+    REQUIRE(calls(trace, "stringBounds") == 0);
+
+    paragraph.setConstraints({100, 100});
+    REQUIRE(paragraph.preferredSize(context) == Vec2{95, 16});
+    REQUIRE(calls(trace, "stringBounds") == 6);
+
+    paragraph.setText("The quick brown fox jumps over");
+    REQUIRE(paragraph.preferredSize(context) == Vec2{95, 16});
+    REQUIRE(wrapped(paragraph) ==
+            std::vector<std::string>{"The quick brown fox", "jumps over"});
+  }
+
+  SECTION("the line breaks are wrapped again for another font") {
+    ScaledSurface scaled(2);
+    Context larger(scaled);
+
+    REQUIRE(paragraph.preferredSize(larger) == Vec2{50, 64});
+    REQUIRE(wrapped(paragraph) ==
+            std::vector<std::string>{"The", "quick", "brown", "fox"});
+
+    REQUIRE(paragraph.preferredSize(context) == Vec2{45, 24});
+    REQUIRE(wrapped(paragraph) ==
+            std::vector<std::string>{"The quick", "brown fox", "jumps"});
+  }
+
+  SECTION("explicit breaks and long words are kept") {
+    paragraph.setText("Unbreakable-word\n\nend");
+    paragraph.preferredSize(context);
+    REQUIRE(wrapped(paragraph) ==
+            std::vector<std::string>{"Unbreakable-word", "", "end"});
+  }
+
+  SECTION("lines beyond the capacity are dropped") {
+    paragraph.setText("a b c d e f");
+    paragraph.setConstraints({5, 100});
+    REQUIRE(paragraph.preferredSize(context) == Vec2{5, 32});
+    REQUIRE(wrapped(paragraph) ==
+            std::vector<std::string>{"a", "b", "c", "d"});
+  }
+
+  SECTION("lines outside of the window are not painted") {
+    layout(paragraph, surface);
+    paragraph.setArea(Rect::with({45, 24}));
+    (void)calls(trace, "drawText");
+
+    paint_full(paragraph, surface, Rect::with({0, 8}, {45, 8}));
+    REQUIRE(calls(trace, "drawText") == 1);
+
+    paint_full(paragraph, surface);
+    REQUIRE(calls(trace, "drawText") == 3);
+  }
+}
@@ -0,0 +1,163 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstdint>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/raster.hpp>
+#include "probe.hpp"
+
+using namespace cui;
+using probe::FrameSink;
+
+namespace {
+constexpr Vec2 resolution{32, 32};
+
+class LayerProbe : public probe::PaintProbe {
+public:
+  using PaintProbe::PaintProbe;
+
+protected:
+  void draw(Canvas& canvas) const noexcept override {
+    canvas.drawRect({{0, 0}, area().size() - 1}, Paint(Color::black()));
+  }
+};
+
+class LayerPanel : public Container {
+public:
+  explicit LayerPanel(Container& parent)
+    : Container(parent) {}
+
+  std::uint16_t pixels_[WideRasterSurface::capacity({8, 8})];
+  RasterLayer layer_{*this, pixels_};
+};
+} // namespace
+
+TEST_CASE("raster layers retain the content of their subtree", "[pipeline]") {
+  FrameSink sink(resolution);
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  Container screen;
+  LayerPanel panel(screen);
+  LayerProbe probe(static_cast<Container&>(panel));
+  LayerProbe sibling(screen);
+
+  layout(screen, surface);
+  panel.setArea(Rect::with({4, 4}, {8, 8}));
+  probe.setArea(Rect::with({4, 4}));
+  sibling.setArea(Rect::with({8, 8}, {4, 4}));
+
+  std::uint16_t const black = WideRasterSurface::encode(Color::black());
+  std::uint16_t const white = WideRasterSurface::encode(Color::white());
+
+  paint_partial(screen, surface);
+  REQUIRE(probe.painted_ == 1);
+  REQUIRE(panel.layer_.isValid());
+  REQUIRE(sink.at({4, 4}) == black);
+
+  SECTION("clean layers are composited") {
+    // The sibling overlaps the panel
+    sibling.change();
+    paint_partial(screen, surface);
+    REQUIRE(sibling.painted_ == 2);
+    REQUIRE(probe.painted_ == 1);
+    REQUIRE(sink.at({4, 4}) == black);
+  }
+
+  SECTION("moved layers are composited") {
+    panel.setPosition({16, 16});
+    paint_partial(screen, surface);
+    REQUIRE(probe.painted_ == 1);
+    REQUIRE(sink.at({4, 4}) == white);
+    REQUIRE(sink.at({16, 16}) == black);
+    REQUIRE(sink.at({19, 19}) == black);
+  }
+
+  SECTION("dirty subtrees record the layer again") {
+    probe.change();
+    REQUIRE_FALSE(panel.layer_.isValid());
+
+    // Dirty Nodes are painted directly, the layer is recorded lazily
+    paint_partial(screen, surface);
+    REQUIRE(probe.painted_ == 2);
+    REQUIRE_FALSE(panel.layer_.isValid());
+
+    panel.setPosition({16, 16});
+    paint_partial(screen, surface);
+    REQUIRE(probe.painted_ == 3);
+    REQUIRE(panel.layer_.isValid());
+    REQUIRE(sink.at({16, 16}) == black);
+  }
+
+  SECTION("layers exceeding their pixels paint the children directly") {
+    panel.setArea(Rect::with({4, 4}, {16, 16}));
+    paint_partial(screen, surface);
+    REQUIRE(probe.painted_ == 2);
+    REQUIRE_FALSE(panel.layer_.isValid());
+    REQUIRE(sink.at({4, 4}) == black);
+  }
+}
+
+TEST_CASE("moved layers under a worklist are composited", "[pipeline]") {
+  FrameSink sink(resolution);
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  probe::WorklistScreen<4> screen;
+  LayerPanel panel(screen);
+  LayerProbe probe(static_cast<Container&>(panel));
+
+  layout(screen, surface);
+  panel.setArea(Rect::with({4, 4}, {8, 8}));
+  probe.setArea(Rect::with({4, 4}));
+
+  std::uint16_t const black = WideRasterSurface::encode(Color::black());
+  std::uint16_t const white = WideRasterSurface::encode(Color::white());
+
+  paint_partial(screen, surface);
+  REQUIRE(probe.painted_ == 1);
+  REQUIRE(panel.layer_.isValid());
+
+  panel.setPosition({16, 16});
+  REQUIRE_FALSE(panel.isPaintDirty());
+  REQUIRE(panel.layer_.isValid());
+
+  paint_partial(screen, surface);
+  REQUIRE(probe.painted_ == 1);
+  REQUIRE(panel.layer_.isValid());
+  REQUIRE(sink.at({4, 4}) == white);
+  REQUIRE(sink.at({16, 16}) == black);
+  REQUIRE(sink.at({19, 19}) == black);
+
+  // The layer follows further moves from its new area
+  panel.setPosition({8, 8});
+  paint_partial(screen, surface);
+  REQUIRE(probe.painted_ == 1);
+  REQUIRE(sink.at({16, 16}) == white);
+  REQUIRE(sink.at({8, 8}) == black);
+
+  SECTION("resized layers are recorded again") {
+    panel.setArea(Rect::with({8, 8}, {6, 6}));
+    paint_partial(screen, surface);
+    REQUIRE(probe.painted_ > 1);
+  }
+}
@@ -0,0 +1,136 @@
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/raster.hpp>
+
+using namespace cui;
+
+namespace {
+/// Keeps every window and its packed values which were passed to the sink
+template <typename SurfaceType>
+struct PackedSink : SurfaceType::Sink {
+  using value_type = typename SurfaceType::value_type;
+
+  Span<value_type> update(Span<value_type> buffer,
+                          Rect const& window) noexcept override {
+    windows.push_back(window);
+    values.emplace_back(buffer.data(),
+                        buffer.data() + SurfaceType::capacity(window.size()));
+    return buffer;
+  }
+
+  std::vector<Rect> windows;
+  std::vector<std::vector<value_type>> values;
+};
+
+template <typename SurfaceType>
+void paint(SurfaceType& surface, Rect const& window,
+           std::initializer_list<Vec2> points) {
+  surface.begin(window);
+  surface.view(Vec2::origin(), window);
+  for (Vec2 point : points) {
+    surface.drawPoint(point, Paint(Color::black()));
+  }
+  surface.end();
+  surface.flush();
+}
+} // namespace
+
+TEST_CASE("trimmed wide raster windows", "[surface]") {
+  using SurfaceType = WideRasterSurface;
+  using value_type = SurfaceType::value_type;
+  constexpr Vec2 resolution{32, 32};
+
+  PackedSink<SurfaceType> sink;
+  std::vector<value_type> buffer(SurfaceType::capacity(resolution));
+  SurfaceType surface(buffer, sink, resolution);
+  surface.setTrimming(true);
+
+  value_type const b = SurfaceType::encode(Color::black());
+  value_type const w = SurfaceType::encode(Color::white());
+
+  SECTION("untouched windows are not passed to the sink") {
+    paint(surface, Rect::with(resolution), {});
+    REQUIRE(sink.windows.empty());
+  }
+
+  SECTION("windows are trimmed to the drawn pixels") {
+    paint(surface, Rect::with(resolution), {{5, 3}, {7, 4}});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows[0] == Rect{{5, 3}, {7, 4}});
+    REQUIRE(sink.values[0] == std::vector<value_type>{b, w, w, //
+                                                      w, w, b});
+  }
+
+  SECTION("trimmed rows are packed out of a partial window") {
+    paint(surface, Rect{{4, 8}, {19, 15}}, {{10, 9}, {12, 11}});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows[0] == Rect{{10, 9}, {12, 11}});
+    REQUIRE(sink.values[0] == std::vector<value_type>{b, w, w, //
+                                                      w, w, w, //
+                                                      w, w, b});
+  }
+
+  SECTION("untrimmed windows are passed completely") {
+    surface.setTrimming(false);
+    paint(surface, Rect{{4, 8}, {19, 15}}, {});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows[0] == Rect{{4, 8}, {19, 15}});
+  }
+}
+
+TEST_CASE("trimmed bit compressed raster windows", "[surface]") {
+  using SurfaceType = BitRasterSurface;
+  using value_type = SurfaceType::value_type;
+  constexpr Vec2 resolution{32, 16};
+
+  PackedSink<SurfaceType> sink;
+  std::vector<value_type> buffer(SurfaceType::capacity(resolution));
+  SurfaceType surface(buffer, sink, resolution);
+  surface.setTrimming(true);
+
+  SECTION("untouched windows are not passed to the sink") {
+    paint(surface, Rect::with(resolution), {});
+    REQUIRE(sink.windows.empty());
+  }
+
+  SECTION("windows are widened to whole bytes") {
+    paint(surface, Rect::with(resolution), {{10, 2}, {20, 3}});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows[0] == Rect{{8, 2}, {23, 3}});
+
+    // Pixels are stored MSB first, drawn pixels clear their bit
+    REQUIRE(sink.values[0] == std::vector<value_type>{0xDF, 0xFF, //
+                                                      0xFF, 0xF7});
+  }
+
+  SECTION("widened windows are clamped to the painted window") {
+    paint(surface, Rect{{8, 4}, {27, 7}}, {{26, 5}});
+    REQUIRE(sink.windows.size() == 1);
+    REQUIRE(sink.windows[0] == Rect{{24, 5}, {27, 5}});
+
+    // The last value of the window only holds 4 pixels
+    REQUIRE(sink.values[0] == std::vector<value_type>{0xDF});
+  }
+}
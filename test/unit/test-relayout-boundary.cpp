@@ -0,0 +1,90 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+
+using namespace cui;
+
+class LayoutProbe : public Container {
+public:
+  LayoutProbe() noexcept = default;
+  explicit LayoutProbe(Container& parent) noexcept
+    : Container(parent) {}
+
+  int layouted_{0};
+
+protected:
+  Vec2 onLayoutEnd(Context& context) noexcept override {
+    ++layouted_;
+    return Container::onLayoutEnd(context);
+  }
+};
+
+TEST_CASE("relayout boundaries absorb size changes", "[layout]") {
+  LayoutProbe root;
+  LayoutProbe group(static_cast<Container&>(root));
+  LayoutProbe panel(static_cast<Container&>(group));
+  Text text(panel);
+  text.setText("short");
+
+  NullSurface surface;
+  layout(root, surface);
+  REQUIRE(root.layouted_ == 1);
+  REQUIRE(group.layouted_ == 1);
+  REQUIRE(panel.layouted_ == 1);
+
+  SECTION("without a boundary the parents are re-evaluated") {
+    text.setText("a much longer text");
+    layout(root, surface);
+
+    REQUIRE(panel.layouted_ == 2);
+    REQUIRE(group.layouted_ == 2);
+  }
+
+  SECTION("a boundary stops the re-evaluation") {
+    panel.setRelayoutBoundary();
+    layout(root, surface);
+    REQUIRE(panel.area().size() == panel.constraints());
+
+    int const layouted = group.layouted_;
+
+    text.setText("a much longer text");
+    layout(root, surface);
+
+    REQUIRE(panel.layouted_ == 3);
+    REQUIRE(group.layouted_ == layouted);
+    REQUIRE(panel.area().size() == panel.constraints());
+  }
+
+  SECTION("a boundary can be layouted alone") {
+    panel.setRelayoutBoundary();
+    layout(root, surface);
+
+    int const layouted = group.layouted_;
+
+    text.setText("a much longer text");
+    layout(panel, surface);
+
+    REQUIRE_FALSE(text.isLayoutDirty());
+    REQUIRE(group.layouted_ == layouted);
+  }
+}
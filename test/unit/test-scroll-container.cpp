@@ -0,0 +1,292 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/raster.hpp>
+#include "probe.hpp"
+
+using namespace cui;
+
+namespace {
+constexpr Vec2 resolution{32, 32};
+
+/// Shifts the kept display content like a display with a scroll support
+struct ScrollSink : probe::FrameSink {
+  ScrollSink()
+    : FrameSink(resolution) {}
+
+  bool scroll(Rect const& area, Vec2 offset) noexcept override {
+    if (!supported) {
+      return false;
+    }
+
+    std::vector<std::uint16_t> const previous = frame;
+    for (Point y = area.low.y; y <= area.high.y; ++y) {
+      for (Point x = area.low.x; x <= area.high.x; ++x) {
+        Vec2 const source = Vec2{x, y} - offset;
+        if (area.contains(source)) {
+          at({x, y}) = previous[source.y * resolution.x + source.x];
+        } else {
+          // The exposed content is undefined until it is painted
+          at({x, y}) = 0x1234;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool supported{true};
+};
+
+class RowProbe : public probe::PaintProbe {
+public:
+  explicit RowProbe(Container& parent, Point index) noexcept
+    : PaintProbe(parent)
+    , index_(index) {}
+
+  Vec2 preferredSize(Context& context) const noexcept override {
+    (void)context;
+    ++measured_;
+    return {resolution.x, 4};
+  }
+
+  mutable int measured_{0};
+
+protected:
+  void draw(Canvas& canvas) const noexcept override {
+    canvas.drawLine({0, 1}, {index_, 1}, Paint(Color::black()));
+  }
+
+private:
+  Point index_;
+};
+
+/// Constrains its children to a size that can be changed
+class Frame : public Container {
+public:
+  void resize(Vec2 size) noexcept {
+    size_ = size;
+    NodeAccess::reflow(*this);
+  }
+
+protected:
+  Constraints onLayoutConstrain(Node& child) noexcept override {
+    (void)child;
+    return size_;
+  }
+
+private:
+  Vec2 size_{resolution};
+};
+
+/// Returns the display content of a full paint of the tree
+std::vector<std::uint16_t> reference(Node& root) {
+  return probe::reference(root, resolution);
+}
+} // namespace
+
+TEST_CASE("scroll containers only paint exposed strips", "[pipeline]") {
+  ScrollSink sink;
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  Container screen;
+  ScrollContainer scroller(screen);
+
+  std::vector<RowProbe> rows;
+  rows.reserve(16);
+  for (Point i = 0; i < 16; ++i) {
+    rows.emplace_back(static_cast<Container&>(scroller), i);
+  }
+
+  layout(screen, surface);
+  REQUIRE(scroller.area() == Rect::with(resolution));
+  REQUIRE(scroller.extent() == Vec2{32, 64});
+
+  // Returns the paint count of every row since the last call
+  auto const painted = [&] {
+    std::vector<int> result;
+    for (RowProbe& row : rows) {
+      result.push_back(std::exchange(row.painted_, 0));
+    }
+    return result;
+  };
+
+  paint_partial(screen, surface);
+  REQUIRE(painted() == std::vector<int>{1, 1, 1, 1, 1, 1, 1, 1, //
+                                        0, 0, 0, 0, 0, 0, 0, 0});
+
+  // Compares the display with a full paint, which paints all visible rows
+  auto const matches = [&] {
+    bool const result = sink.frame == reference(screen);
+    (void)painted();
+    return result;
+  };
+
+  SECTION("shifted content only paints the exposed rows") {
+    scroller.scrollBy({0, 6});
+    REQUIRE(scroller.offset() == Vec2{0, 6});
+
+    paint_partial(screen, surface);
+    REQUIRE(painted() == std::vector<int>{0, 0, 0, 0, 0, 0, 0, 0, //
+                                          1, 1, 0, 0, 0, 0, 0, 0});
+    REQUIRE(matches());
+
+    scroller.scrollBy({0, -3});
+    paint_partial(screen, surface);
+    REQUIRE(painted() == std::vector<int>{1, 1, 0, 0, 0, 0, 0, 0, //
+                                          0, 0, 0, 0, 0, 0, 0, 0});
+    REQUIRE(matches());
+  }
+
+  SECTION("surfaces without shifting repaint the viewport") {
+    sink.supported = false;
+
+    scroller.scrollBy({0, 6});
+    paint_partial(screen, surface);
+    REQUIRE(painted() == std::vector<int>{0, 1, 1, 1, 1, 1, 1, 1, //
+                                          1, 1, 0, 0, 0, 0, 0, 0});
+    REQUIRE(matches());
+  }
+
+  SECTION("dirty children are painted after the shift") {
+    scroller.scrollBy({0, 4});
+    NodeAccess::repaint(rows[2]);
+
+    paint_partial(screen, surface);
+    REQUIRE(painted() == std::vector<int>{0, 0, 1, 0, 0, 0, 0, 0, //
+                                          1, 0, 0, 0, 0, 0, 0, 0});
+    REQUIRE(matches());
+  }
+
+  SECTION("the offset stays inside the extent") {
+    scroller.scrollTo({0, 1000});
+    REQUIRE(scroller.offset() == Vec2{0, 32});
+
+    scroller.scrollTo({-5, -5});
+    REQUIRE(scroller.offset() == Vec2::origin());
+  }
+}
+
+TEST_CASE("scroll containers inside static trees shift their content",
+          "[pipeline]") {
+  ScrollSink sink;
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  Inplace tree(type_identity<Container>{}, inplace, ScrollContainer());
+  ScrollContainer& scroller = std::get<0>(tree.elements());
+
+  std::vector<RowProbe> rows;
+  rows.reserve(16);
+  for (Point i = 0; i < 16; ++i) {
+    rows.emplace_back(static_cast<Container&>(scroller), i);
+  }
+
+  static_layout(tree, surface);
+  static_paint_partial(tree, surface);
+
+  scroller.scrollBy({0, 6});
+  static_paint_partial(tree, surface);
+
+  std::vector<int> painted;
+  for (RowProbe& row : rows) {
+    painted.push_back(row.painted_);
+  }
+  REQUIRE(painted == std::vector<int>{1, 1, 1, 1, 1, 1, 1, 1, //
+                                      1, 1, 0, 0, 0, 0, 0, 0});
+  REQUIRE(sink.frame == reference(*tree));
+  REQUIRE_FALSE(tree->isChildScrolled());
+}
+
+TEST_CASE("scroll containers defer the layout of hidden children",
+          "[layout]") {
+  ScrollSink sink;
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  Frame screen;
+  ScrollContainer scroller(screen);
+
+  std::vector<RowProbe> rows;
+  rows.reserve(16);
+  for (Point i = 0; i < 16; ++i) {
+    rows.emplace_back(static_cast<Container&>(scroller), i);
+  }
+
+  // Every child is measured once for the extent
+  layout(screen, surface);
+  REQUIRE(scroller.extent() == Vec2{32, 64});
+
+  // Returns the layout count of every row since the last call
+  auto const measured = [&] {
+    std::vector<int> result;
+    for (RowProbe& row : rows) {
+      result.push_back(std::exchange(row.measured_, 0));
+    }
+    return result;
+  };
+  REQUIRE(measured() == std::vector<int>(16, 1));
+  REQUIRE_FALSE(rows[7].isLayoutCulled());
+  REQUIRE(rows[8].isLayoutCulled());
+
+  NodeAccess::reflow(rows[2]);
+  NodeAccess::reflow(rows[12]);
+  layout(screen, surface);
+  REQUIRE(measured() == std::vector<int>{0, 0, 1, 0, 0, 0, 0, 0, //
+                                         0, 0, 0, 0, 0, 0, 0, 0});
+  REQUIRE(rows[12].isLayoutDirty());
+
+  SECTION("hidden children are laid out when they are scrolled in") {
+    scroller.scrollBy({0, 20});
+    REQUIRE(scroller.isLayoutDirty());
+    REQUIRE(rows[2].isLayoutCulled());
+
+    layout(screen, surface);
+    REQUIRE(measured() == std::vector<int>{0, 0, 0, 0, 0, 0, 0, 0, //
+                                           0, 0, 0, 0, 1, 0, 0, 0});
+    REQUIRE_FALSE(rows[12].isLayoutDirty());
+    REQUIRE(rows[0].isLayoutCulled());
+    REQUIRE_FALSE(rows[12].isLayoutCulled());
+
+    paint_partial(screen, surface);
+    REQUIRE(sink.frame == reference(screen));
+  }
+
+  SECTION("constraint changes only relayout the visible children") {
+    screen.resize({24, 32});
+    layout(screen, surface);
+    REQUIRE(measured() == std::vector<int>{1, 1, 1, 1, 1, 1, 1, 1, //
+                                           0, 0, 0, 0, 0, 0, 0, 0});
+    REQUIRE(rows[8].constraints() == resolution);
+
+    scroller.scrollBy({0, 32});
+    REQUIRE(scroller.isLayoutDirty());
+
+    layout(screen, surface);
+    REQUIRE(measured() == std::vector<int>{0, 0, 0, 0, 0, 0, 0, 0, //
+                                           1, 1, 1, 1, 1, 1, 1, 1});
+    REQUIRE(rows[8].constraints() == Vec2{24, 32});
+  }
+}
@@ -0,0 +1,167 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstddef>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+
+using namespace cui;
+
+namespace {
+class ShapeProbe : public Widget {
+public:
+  using Widget::Widget;
+
+  bool collides(Rect const& area) const noexcept override {
+    (void)area;
+    return solid_;
+  }
+
+  bool solid_{true};
+};
+
+class Board : public Container {
+public:
+  using Container::Container;
+};
+
+class OrderedBoard : public Container {
+public:
+  using Container::Container;
+
+  SiblingOrder<16> order_{*this};
+};
+
+/// Returns the count of colliding pairs by comparing all children
+std::size_t brute_force(Container const& container) {
+  std::size_t count = 0;
+  for (Node const& left : container.children()) {
+    for (Node const& right : left.siblings()) {
+      count += ((&left != &right) && collides(left, right)) ? 1 : 0;
+    }
+  }
+  return count;
+}
+
+/// Returns true if the collision state of every child matches the pairs
+bool consistent(Container const& container) {
+  for (Node const& child : container.children()) {
+    bool expected = false;
+    for (Node const& other : container.children()) {
+      expected = expected || ((&other != &child) && collides(child, other));
+    }
+
+    if (collides(child) != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+void arrange(T& board, ShapeProbe (&probes)[8]) {
+  board.setArea(Rect::with({64, 32}));
+
+  for (std::size_t i = 0; i < 8; ++i) {
+    board.push_back(probes[i]);
+
+    // Arranged from right to left, overlapping their neighbours
+    Point const x = static_cast<Point>(60 - i * 9);
+    probes[i].setArea(Rect::with({x, static_cast<Point>(i % 3 * 6)},
+                                 {12, 12}));
+  }
+
+  // A sibling outside of the visible area of the board
+  probes[7].setArea(Rect::with({100, 0}, {12, 12}));
+  probes[3].solid_ = false;
+}
+
+std::size_t pairs(Container const& container) {
+  Node const* storage[8];
+  std::size_t count = 0;
+
+  bool const swept = collisions(container, storage,
+                                [&](Node const& left, Node const& right) {
+                                  CHECK(collides(left, right));
+                                  ++count;
+                                });
+  REQUIRE(swept);
+  return count;
+}
+} // namespace
+
+TEST_CASE("sibling collisions are swept", "[collision]") {
+  Board board;
+  ShapeProbe probes[8];
+  arrange(board, probes);
+
+  std::size_t const expected = brute_force(board);
+  REQUIRE(expected == 3);
+  REQUIRE(pairs(board) == expected);
+  REQUIRE(consistent(board));
+
+  SECTION("insufficient storage") {
+    Node const* storage[4];
+    REQUIRE_FALSE(collisions(board, storage, [](Node const&, Node const&) {
+      FAIL("No pair is visited");
+    }));
+  }
+}
+
+TEST_CASE("sibling orders follow the children", "[collision]") {
+  OrderedBoard board;
+  ShapeProbe probes[8];
+  arrange(board, probes);
+
+  REQUIRE(board.order_.isStale());
+  REQUIRE(board.order_.available());
+  REQUIRE_FALSE(board.order_.isStale());
+
+  Span<Node const* const> const entries = board.order_.entries();
+  REQUIRE(entries.size() == 8);
+  for (std::size_t i = 1; i < entries.size(); ++i) {
+    REQUIRE(entries[i - 1]->area().low.x <= entries[i]->area().low.x);
+  }
+
+  REQUIRE(pairs(board) == brute_force(board));
+  REQUIRE(consistent(board));
+
+  SECTION("on moved areas") {
+    probes[0].setPosition({0, 20});
+    probes[5].setPosition({50, 8});
+    REQUIRE(board.order_.isStale());
+
+    REQUIRE(pairs(board) == brute_force(board));
+    REQUIRE(consistent(board));
+  }
+
+  SECTION("on insertion and erasure") {
+    ShapeProbe inserted(board);
+    inserted.setArea(Rect::with({0, 0}, {64, 32}));
+    REQUIRE(board.order_.isStale());
+    REQUIRE(pairs(board) == brute_force(board));
+    REQUIRE(consistent(board));
+
+    board.erase(probes[2]);
+    REQUIRE(board.order_.isStale());
+    REQUIRE(pairs(board) == brute_force(board));
+    REQUIRE(consistent(board));
+  }
+}
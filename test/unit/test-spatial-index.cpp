@@ -0,0 +1,150 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstddef>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+
+using namespace cui;
+
+namespace {
+class CellProbe : public Widget {
+public:
+  using Widget::Widget;
+};
+
+template <std::size_t Entries>
+class IndexedScreen : public Container {
+public:
+  using Container::Container;
+
+  BasicNodeArena<32> arena_;
+  BasicSpatialGrid<4, 4, Entries> grid_;
+  SpatialIndex index_{*this, arena_, grid_};
+};
+
+/// Returns true if every position of the screen hits the same Node as the
+/// linear descent through a freshly assigned arena
+template <std::size_t Entries>
+bool matches(IndexedScreen<Entries>& screen) {
+  BasicNodeArena<32> reference;
+  reference.assign(screen);
+  reference.refresh();
+
+  for (Point y = -2; y < 66; ++y) {
+    for (Point x = -2; x < 66; ++x) {
+      NodeArena::Index const index = reference.intersection({x, y});
+      Node const* const expected = (index == NodeArena::npos)
+                                       ? nullptr
+                                       : &reference.node(index);
+
+      if (intersection(screen, {x, y}) != expected) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("spatial indices match the tree", "[spatial]") {
+  IndexedScreen<128> screen;
+  Container left(screen);
+  Container right(screen);
+  CellProbe cells[6];
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    left.push_back(cells[i]);
+    right.push_back(cells[3 + i]);
+  }
+
+  screen.setArea(Rect::with({64, 64}));
+  left.setArea(Rect::with({0, 0}, {40, 64}));
+  right.setArea(Rect::with({24, 8}, {40, 48}));
+
+  // Overlapping cells of different sizes, partially clipped by the parents
+  for (std::size_t i = 0; i < 6; ++i) {
+    Point const offset = static_cast<Point>((i % 3) * 14);
+    cells[i].setArea(Rect::with({offset, offset}, {20, 20}));
+  }
+
+  REQUIRE(screen.index_.isStale());
+  REQUIRE(screen.index_.available());
+  REQUIRE_FALSE(screen.index_.isStale());
+  REQUIRE(screen.grid_.valid());
+  REQUIRE(matches(screen));
+
+  SECTION("area queries visit every overlapping node once") {
+    Rect const area = Rect::with({20, 20}, {8, 8});
+
+    std::size_t visited = 0;
+    std::size_t expected = 0;
+    screen.index_.overlapping(area, [&](Node& current) {
+      REQUIRE(current.clipSpace().overlaps(area));
+      ++visited;
+    });
+
+    for (Node& current : visit(screen)) {
+      if (current.clipSpace().overlaps(area)) {
+        ++expected;
+      }
+    }
+
+    REQUIRE(visited == expected);
+  }
+
+  SECTION("moved nodes") {
+    cells[4].setPosition({2, 30});
+    REQUIRE(screen.index_.isStale());
+    REQUIRE(matches(screen));
+
+    right.setPosition({0, 0});
+    REQUIRE(screen.index_.isStale());
+    REQUIRE(matches(screen));
+  }
+
+  SECTION("inserted and erased nodes") {
+    CellProbe inserted(screen);
+    inserted.setArea(Rect::with({56, 58}, {4, 4}));
+    REQUIRE(screen.index_.isStale());
+    REQUIRE(matches(screen));
+    REQUIRE(intersection(screen, {57, 59}) == &inserted);
+
+    left.erase(cells[0]);
+    REQUIRE(screen.index_.isStale());
+    REQUIRE(matches(screen));
+  }
+
+}
+
+TEST_CASE("spatial indices fall back to the arena", "[spatial]") {
+  IndexedScreen<4> screen;
+  CellProbe cells[4];
+
+  screen.setArea(Rect::with({64, 64}));
+  for (std::size_t i = 0; i < 4; ++i) {
+    screen.push_back(cells[i]);
+    cells[i].setArea(Rect::with({static_cast<Point>(i * 10), 0}, {40, 40}));
+  }
+
+  REQUIRE(screen.index_.available());
+  REQUIRE_FALSE(screen.grid_.valid());
+  REQUIRE(matches(screen));
+}
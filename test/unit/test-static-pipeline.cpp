@@ -0,0 +1,100 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+
+using namespace cui;
+
+static auto make_tree() {
+  return Align(Alignment{AlignOrientation::Vertical},
+               Padding(Text("first")), Fill(Text("second")),
+               Text("third"));
+}
+
+static std::vector<Rect> areas_of(Node& node) {
+  std::vector<Rect> areas;
+
+  for (Accept& current : traverse(node)) {
+    if (current.isPre()) {
+      REQUIRE_FALSE(current->isLayoutDirty());
+      REQUIRE_FALSE(current->isChildLayoutDirty());
+
+      areas.push_back(current->area());
+    }
+  }
+
+  return areas;
+}
+
+TEST_CASE("Inplace trees are layouted statically", "[pipeline]") {
+  auto dynamic = make_tree();
+  auto statically = make_tree();
+
+  NullSurface dynamic_surface;
+  NullSurface static_surface;
+
+  layout(*dynamic, dynamic_surface);
+  static_layout(statically, static_surface);
+  REQUIRE(areas_of(*dynamic) == areas_of(*statically));
+
+  SECTION("relayouts resized children") {
+    std::get<2>(dynamic.elements()).setText("a much longer third");
+    std::get<2>(statically.elements()).setText("a much longer third");
+
+    layout(*dynamic, dynamic_surface);
+    static_layout(statically, static_surface);
+    REQUIRE(areas_of(*dynamic) == areas_of(*statically));
+  }
+
+  SECTION("falls back on children changed at runtime") {
+    Text dynamic_text("fourth");
+    Text static_text("fourth");
+    dynamic->push_back(dynamic_text);
+    statically->push_back(static_text);
+
+    layout(*dynamic, dynamic_surface);
+    static_layout(statically, static_surface);
+    REQUIRE(areas_of(*dynamic) == areas_of(*statically));
+  }
+
+  SECTION("paints containers which are no Inplace tree") {
+    auto tree = Inplace(type_identity<Container>{}, inplace, Container());
+    Text text(std::get<0>(tree.elements()), "nested");
+
+    static_layout(tree, static_surface);
+    static_paint_full(tree, static_surface);
+    static_paint_partial(tree, static_surface);
+
+    for (Accept& current : traverse(*tree)) {
+      REQUIRE_FALSE(current->isPaintDirty());
+    }
+  }
+
+  SECTION("paints partially") {
+    static_paint_partial(statically, static_surface);
+
+    for (Accept& current : traverse(*statically)) {
+      REQUIRE_FALSE(current->isPaintDirty());
+    }
+  }
+}
@@ -0,0 +1,147 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/null.hpp>
+
+using namespace cui;
+
+namespace {
+/// Measures glyphs with a proportional font and paints nothing
+class ProportionalSurface final : public Surface {
+public:
+  Vec2 resolution() const noexcept override {
+    return {64, 64};
+  }
+
+  void view(Vec2 offset, Rect const& clip_space) noexcept override {
+    (void)offset;
+    (void)clip_space;
+  }
+
+  void drawPoint(Vec2, Paint const&) noexcept override {}
+  void drawLine(Vec2, Vec2, Paint const&) noexcept override {}
+  void drawRect(Rect const&, Paint const&) noexcept override {}
+  void drawCircle(Vec2, Point, Paint const&) noexcept override {}
+  void drawImage(Rect const&, Span<std::uint16_t const>) noexcept override {}
+  void drawBitImage(Rect const&, Span<std::uint8_t const>,
+                    Paint const&) noexcept override {}
+  void drawText(Vec2, std::string_view, Paint const&) noexcept override {}
+
+  Vec2 stringBounds(std::string_view str) noexcept override {
+    Point width = 0;
+    for (char glyph : str) {
+      width = static_cast<Point>(width + glyphAdvance(glyph));
+    }
+    return {width, 8};
+  }
+
+  Point glyphAdvance(char glyph) noexcept override {
+    switch (glyph) {
+      case '1':
+        return 3;
+      case '2':
+        return 4;
+      case ':':
+        return 2;
+      default:
+        return 5;
+    }
+  }
+};
+} // namespace
+
+TEST_CASE("texts only repaint their changed glyphs", "[widget]") {
+  Container screen;
+  Text label(screen, "12:00");
+
+  NullSurface surface;
+  REQUIRE(surface.glyphAdvance('1') == 5);
+
+  layout(screen, surface);
+  paint_partial(screen, surface);
+  REQUIRE(label.area().size() == Vec2{25, 8});
+
+  SECTION("changed glyphs of the same length are damaged") {
+    label.setText("12:05");
+    REQUIRE_FALSE(label.isPaintDirty());
+
+    layout(screen, surface);
+    REQUIRE(label.isPaintDamaged());
+    REQUIRE(label.damage() == Rect{{20, 0}, {24, 7}});
+
+    label.setText("13:07");
+    label.setText("13:08");
+    layout(screen, surface);
+    REQUIRE(label.damage() == Rect{{5, 0}, {24, 7}});
+
+    paint_partial(screen, surface);
+    REQUIRE_FALSE(label.isPaintDirty());
+  }
+
+  SECTION("equal texts are not repainted") {
+    label.setText("12:00");
+    REQUIRE_FALSE(label.isPaintDirty());
+  }
+
+  SECTION("texts of a different length are reflowed") {
+    label.setText("12:00:00");
+    REQUIRE(label.isLayoutDirty());
+    REQUIRE(label.isPaintDirty());
+    REQUIRE_FALSE(label.isPaintDamaged());
+  }
+
+  SECTION("multiple lines are reflowed") {
+    label.setText("12\n00");
+    REQUIRE(label.isLayoutDirty());
+  }
+}
+
+TEST_CASE("texts locate changed glyphs through their advances", "[widget]") {
+  Container screen;
+  Text label(screen, "10:21");
+
+  ProportionalSurface surface;
+  layout(screen, surface);
+  paint_partial(screen, surface);
+  REQUIRE(label.area().size() == Vec2{17, 8});
+
+  SECTION("glyphs of the same summed advance keep their position") {
+    label.setText("12:01");
+    layout(screen, surface);
+    REQUIRE(label.isPaintDamaged());
+    REQUIRE(label.damage() == Rect{{3, 0}, {13, 7}});
+
+    paint_partial(screen, surface);
+    REQUIRE_FALSE(label.isPaintDirty());
+  }
+
+  SECTION("changed bounds repaint the whole text") {
+    label.setText("11:21");
+    layout(screen, surface);
+    REQUIRE(label.area().size() == Vec2{15, 8});
+    REQUIRE(screen.isPaintDirty());
+    REQUIRE_FALSE(label.isPaintDamaged());
+  }
+}
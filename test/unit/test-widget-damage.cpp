@@ -0,0 +1,132 @@
+
+/*
+  CUI - A component-based C++ UI library
+
+  Copyright (C) 2020-2021 Denis Blank <denis.blank at outlook dot com>
+
+  This program is free software: you can redistribute it and/or modify
+  it under the terms of the GNU Lesser General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public License
+  along with this program. If not, see <https://www.gnu.org/licenses/>.
+**/
+
+#include <cstdint>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <cui/cui.hpp>
+#include <cui/surface/raster.hpp>
+#include "probe.hpp"
+
+using namespace cui;
+
+namespace {
+constexpr Vec2 resolution{32, 32};
+
+/// Draws one column per sample
+class ChartProbe : public probe::PaintProbe {
+public:
+  using PaintProbe::PaintProbe;
+
+  void append(Point sample) noexcept {
+    samples_.push_back(sample);
+
+    Point const x = static_cast<Point>(samples_.size() - 1);
+    repaint(Rect::with({x, 0}, {1, area().height()}));
+  }
+
+  void invalidate(Rect const& area) noexcept {
+    repaint(area);
+  }
+
+  void reset() noexcept {
+    samples_.clear();
+    repaint();
+  }
+
+protected:
+  void draw(Canvas& canvas) const noexcept override {
+    for (std::size_t i = 0; i < samples_.size(); ++i) {
+      Point const x = static_cast<Point>(i);
+      canvas.drawLine({x, 0}, {x, samples_[i]}, Paint(Color::black()));
+    }
+  }
+
+private:
+  std::vector<Point> samples_;
+};
+
+/// Returns the display content of a full paint of the tree
+std::vector<std::uint16_t> reference(Node& root) {
+  return probe::reference(root, resolution);
+}
+} // namespace
+
+TEST_CASE("widgets repaint their damaged area only", "[pipeline]") {
+  probe::FrameSink sink(resolution);
+  std::vector<std::uint16_t> buffer(WideRasterSurface::capacity(resolution));
+  WideRasterSurface surface(buffer, sink, resolution);
+
+  Container screen;
+  ChartProbe chart(screen);
+
+  layout(screen, surface);
+  chart.setArea(Rect::with({4, 4}, {16, 16}));
+
+  paint_partial(screen, surface);
+  REQUIRE(chart.painted_ == 1);
+  sink.windows.clear();
+
+  SECTION("appended samples only rasterize their column") {
+    chart.append(3);
+    chart.append(5);
+    REQUIRE(chart.isPaintDamaged());
+    REQUIRE(chart.damage() == Rect::with({0, 0}, {2, 16}));
+
+    paint_partial(screen, surface);
+    REQUIRE(chart.painted_ == 2);
+    REQUIRE_FALSE(chart.isPaintDirty());
+    REQUIRE_FALSE(chart.isPaintDamaged());
+    REQUIRE_FALSE(chart.damage());
+
+    REQUIRE_FALSE(sink.windows.empty());
+    for (Rect const& window : sink.windows) {
+      REQUIRE(Rect::with({4, 4}, {2, 16}).contains(window));
+    }
+    REQUIRE(sink.frame == reference(screen));
+  }
+
+  SECTION("damage outside of the widget is ignored") {
+    chart.invalidate(Rect::with({-8, -8}, {4, 4}));
+    REQUIRE_FALSE(chart.isPaintDirty());
+  }
+
+  SECTION("a full repaint is never limited") {
+    chart.append(3);
+    chart.reset();
+    chart.append(7);
+    REQUIRE_FALSE(chart.isPaintDamaged());
+
+    paint_partial(screen, surface);
+    REQUIRE_FALSE(chart.isPaintDamaged());
+    REQUIRE(Rect::with({4, 4}, {16, 16}) == sink.windows.front());
+    REQUIRE(sink.frame == reference(screen));
+  }
+
+  SECTION("moved widgets are repainted entirely") {
+    chart.append(3);
+    chart.setPosition({8, 8});
+    REQUIRE_FALSE(chart.isPaintDamaged());
+
+    paint_partial(screen, surface);
+    REQUIRE_FALSE(chart.isPaintDamaged());
+    REQUIRE(sink.frame == reference(screen));
+  }
+}